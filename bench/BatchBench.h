@@ -0,0 +1,80 @@
+/**
+ * @file BatchBench.h
+ * @brief Batched membership benchmark: one-by-one joins/leaves vs one batch
+ * @details Builds two identical rings with stored files, scales both out
+ *          (and back in) by the same set of machines, and checks that every
+ *          file ends up on the machine responsible for its key.
+ *
+ * Compile: g++ -std=c++17 -O2 -Isrc -o ipfs_bench bench/bench_main.cpp
+ */
+
+#pragma once
+#include "BenchUtil.h"
+#include "RingFixture.h"
+
+/**
+ * @brief ipfs_bench batch [--machines=N] [--files=F] [--bits=B]
+ */
+inline int runBatchBench(int argc, char** argv) {
+    int machines = static_cast<int>(getOption(argc, argv, "machines", 1000));
+    int numFiles = static_cast<int>(getOption(argc, argv, "files", 100000));
+    int bits = static_cast<int>(getOption(argc, argv, "bits", 24));
+    const int order = 5;
+
+    printBenchHeader("BATCHED MEMBERSHIP: one-by-one vs single merge pass");
+    cout << "  Ring of " << machines << " machines and " << numFiles << " files in a "
+         << bits << "-bit space;\n";
+    cout << "  scale out by N machines, then scale back in by the same N.\n\n";
+
+    mt19937_64 rng(7);
+    vector<uint64_t> ids = uniqueRandomKeys(static_cast<size_t>(machines) * 2, bits, rng);
+    shuffle(ids.begin(), ids.end(), rng);
+    vector<uint64_t> initial(ids.begin(), ids.begin() + machines);
+    vector<int> extra;
+    for (size_t i = static_cast<size_t>(machines); i < ids.size(); i++) {
+        extra.push_back(static_cast<int>(ids[i]));
+    }
+    vector<uint64_t> files = uniqueRandomKeys(static_cast<size_t>(numFiles), bits, rng);
+
+    vector<int> widths = { 10, 12, 12, 10, 10, 12 };
+    printRule(widths);
+    printRow({ "Change", "Mode", "Total ms", "Moved", "Rebuilds", "Placement" }, widths);
+    printRule(widths);
+
+    CircularLinkedList* single = buildRing(bits, initial, files, order);
+    CircularLinkedList* batched = buildRing(bits, initial, files, order);
+    bool allOk = true;
+
+    for (int phase = 0; phase < 2; phase++) {
+        string change = (phase == 0 ? "+" : "-") + to_string(extra.size());
+
+        Stopwatch sw;
+        for (int id : extra) {
+            if (phase == 0) {
+                single->insertAfter(id, order);
+            } else {
+                single->deletekey(id, order);
+            }
+        }
+        double singleMs = sw.elapsedMs();
+        bool singleOk = filesPlacedCorrectly(single, files.size());
+
+        sw.reset();
+        int moved = phase == 0 ? batched->applyMembershipBatch(extra, {}, order)
+                               : batched->applyMembershipBatch({}, extra, order);
+        double batchMs = sw.elapsedMs();
+        bool batchOk = filesPlacedCorrectly(batched, files.size());
+        allOk = allOk && singleOk && batchOk;
+
+        printRow({ change, "one-by-one", fixedStr(singleMs, 1), "-", to_string(extra.size()),
+                   singleOk ? "OK" : "MISMATCH" }, widths);
+        printRow({ change, "batch", fixedStr(batchMs, 1), to_string(moved), "1",
+                   batchOk ? "OK" : "MISMATCH" }, widths);
+        printRow({ "", "speedup", fixedStr(singleMs / batchMs, 1) + "x", "", "", "" }, widths);
+    }
+    printRule(widths);
+
+    delete single;
+    delete batched;
+    return allOk ? 0 : 1;
+}
@@ -0,0 +1,145 @@
+/**
+ * @file BenchUtil.h
+ * @brief Shared helpers for the ipfs_bench benchmark driver
+ * @details Timing, option parsing, key generation and table output
+ * 
+ * Compile: g++ -std=c++17 -O2 -Isrc -o ipfs_bench bench/bench_main.cpp
+ */
+
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief Wall-clock stopwatch
+ */
+class Stopwatch {
+public:
+    chrono::steady_clock::time_point start;
+
+    Stopwatch() : start(chrono::steady_clock::now()) {}
+
+    void reset() { start = chrono::steady_clock::now(); }
+
+    double elapsedNs() const {
+        return static_cast<double>(chrono::duration_cast<chrono::nanoseconds>(
+            chrono::steady_clock::now() - start).count());
+    }
+
+    double elapsedMs() const { return elapsedNs() / 1e6; }
+};
+
+/**
+ * @brief Keeps benchmark results observable so loops are not optimized away
+ */
+inline volatile uint64_t benchSink = 0;
+
+/**
+ * @brief Read --name=value from the command line
+ */
+inline long long getOption(int argc, char** argv, const string& name, long long defaultValue) {
+    string prefix = "--" + name + "=";
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg.compare(0, prefix.size(), prefix) == 0) {
+            return stoll(arg.substr(prefix.size()));
+        }
+    }
+    return defaultValue;
+}
+
+/**
+ * @brief Check for a bare --flag on the command line
+ */
+inline bool hasFlag(int argc, char** argv, const string& name) {
+    string flag = "--" + name;
+    for (int i = 1; i < argc; i++) {
+        if (flag == argv[i]) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief n distinct uniformly random keys in [0, 2^bits), sorted
+ */
+inline vector<uint64_t> uniqueRandomKeys(size_t n, int bits, mt19937_64& rng) {
+    uint64_t mask = bits >= 64 ? ~0ULL : ((1ULL << bits) - 1);
+    vector<uint64_t> keys;
+    keys.reserve(n);
+    while (keys.size() < n) {
+        while (keys.size() < n) keys.push_back(rng() & mask);
+        sort(keys.begin(), keys.end());
+        keys.erase(unique(keys.begin(), keys.end()), keys.end());
+    }
+    return keys;
+}
+
+inline string formatBytes(double bytes) {
+    const char* units[] = { "B", "KB", "MB", "GB" };
+    int u = 0;
+    while (bytes >= 1024.0 && u < 3) {
+        bytes /= 1024.0;
+        u++;
+    }
+    ostringstream out;
+    out << fixed << setprecision(u == 0 ? 0 : 1) << bytes << " " << units[u];
+    return out.str();
+}
+
+inline string formatCount(uint64_t n) {
+    if (n >= 1000000 && n % 1000000 == 0) return to_string(n / 1000000) + "M";
+    if (n >= 1000 && n % 1000 == 0) return to_string(n / 1000) + "k";
+    return to_string(n);
+}
+
+/**
+ * @brief Print a boxed benchmark title
+ */
+inline void printBenchHeader(const string& title) {
+    cout << "\n  +========================================================================+\n";
+    cout << "  |  " << setw(70) << left << title << "|\n";
+    cout << "  +========================================================================+\n";
+}
+
+/**
+ * @brief Fixed-width table row; numbers are formatted by the caller
+ */
+inline void printRow(const vector<string>& cells, const vector<int>& widths) {
+    cout << "  ";
+    for (size_t i = 0; i < cells.size(); i++) {
+        cout << "| " << setw(widths[i]) << left << cells[i] << " ";
+    }
+    cout << "|\n";
+}
+
+inline void printRule(const vector<int>& widths) {
+    cout << "  ";
+    for (int w : widths) {
+        cout << "+" << string(w + 2, '-');
+    }
+    cout << "+\n";
+}
+
+/**
+ * @brief Value at quantile p (0..1) of an unsorted sample
+ */
+inline double percentile(vector<double> values, double p) {
+    sort(values.begin(), values.end());
+    size_t i = static_cast<size_t>(p * (values.size() - 1));
+    return values[i];
+}
+
+inline string fixedStr(double value, int precision) {
+    ostringstream out;
+    out << fixed << setprecision(precision) << value;
+    return out.str();
+}
@@ -0,0 +1,137 @@
+/**
+ * @file BlockBench.h
+ * @brief File bytes in per-machine block logs: handoff throughput and compaction
+ * @details Runs the same load, joins, leaves and deletes twice: with the
+ *          B-trees as the only storage (paths and sizes) and with every
+ *          machine's append-only block log holding the file contents. Joins
+ *          and leaves go through the synchronous handoff (Traverse_insert /
+ *          Traverse_delete), so with the block store they read, append and
+ *          release real bytes. Reports time per phase, bytes moved between
+ *          logs and MB/s, checks every file reads back intact, and shows the
+ *          space reclaimed by compaction after deleting half the files.
+ *
+ * Compile: g++ -std=c++17 -O2 -Isrc -o ipfs_bench bench/bench_main.cpp
+ */
+
+#pragma once
+#include "BenchUtil.h"
+#include "IPFS.h"
+#include "RingFixture.h"
+
+/**
+ * @brief ipfs_bench blocks [--machines=N] [--files=F] [--churn=C] [--segment=KB]
+ */
+inline int runBlockBench(int argc, char** argv) {
+    int machines = static_cast<int>(getOption(argc, argv, "machines", 64));
+    int numFiles = static_cast<int>(getOption(argc, argv, "files", 4000));
+    int churn = static_cast<int>(getOption(argc, argv, "churn", 16));
+    long long segmentBytes = static_cast<long long>(getOption(argc, argv, "segment", 256)) * 1024;
+    const int bits = 24;
+    const int order = 5;
+    const string dir = "ipfs_bench_blocks";
+    const double MB = 1024.0 * 1024.0;
+
+    mt19937_64 rng(151);
+    vector<uint64_t> all = uniqueRandomKeys(static_cast<size_t>(machines + churn + numFiles), bits, rng);
+    shuffle(all.begin(), all.end(), rng);
+    vector<int> idList(all.begin(), all.begin() + machines);
+    vector<int> joiners(all.begin() + machines, all.begin() + machines + churn);
+    vector<uint64_t> files(all.begin() + machines + churn, all.end());
+    long long totalBytes = 0;
+    for (uint64_t key : files) totalBytes += fileSizeFor(key);
+
+    printBenchHeader("BLOCK STORE: append-only logs with real file bytes");
+    cout << "  " << machines << " machines, " << numFiles << " files (" << fixedStr(totalBytes / MB, 1)
+         << " MB); " << churn << " joins then " << churn << " leaves; " << segmentBytes / 1024
+         << " KB segments in ./" << dir << "\n\n";
+
+    struct Phase {
+        string name;
+        double indexMs;
+        double blockMs;
+        double mb;          // Bytes read, written or moved with the block store
+    };
+    vector<Phase> phases = { { "Put", 0, 0, 0 }, { "Read back", 0, 0, 0 }, { "Joins", 0, 0, 0 },
+                             { "Leaves", 0, 0, 0 }, { "Delete half", 0, 0, 0 } };
+    BlockStats afterLoad = {}, afterDelete = {};
+    long long corrupt = 0;
+
+    for (bool blocks : { false, true }) {
+        IPFS ipfs(bits, order);
+        ipfs.SetVerbose(false);
+        ipfs.ApplyMembershipBatch(idList, {});
+        if (blocks && ipfs.EnableBlockStore(dir, segmentBytes) < 0) {
+            cout << "  ERROR: cannot create ./" << dir << "\n";
+            return 1;
+        }
+        auto record = [&](size_t phase, double ms) {
+            (blocks ? phases[phase].blockMs : phases[phase].indexMs) = ms;
+        };
+
+        Stopwatch sw;
+        for (uint64_t key : files) ipfs.Put(static_cast<int>(key), "file_" + to_string(key), fileSizeFor(key));
+        record(0, sw.elapsedMs());
+        if (blocks) {
+            afterLoad = ipfs.C->blockStats();
+            phases[0].mb = afterLoad.bytesAppended / MB;
+        }
+
+        string data;
+        double readMs = 0;
+        for (uint64_t key : files) {
+            sw.reset();
+            bool ok = blocks ? ipfs.ReadData(static_cast<int>(key), data) : ipfs.Get(static_cast<int>(key)) != nullptr;
+            readMs += sw.elapsedMs();
+            if (!ok || (blocks && data != BlockLog::payloadFor(static_cast<int>(key), fileSizeFor(key)))) corrupt++;
+        }
+        record(1, readMs);
+        if (blocks) phases[1].mb = ipfs.C->blockStats().bytesRead / MB;
+
+        long long handedIn = ipfs.C->blockStats().bytesHandedIn;
+        sw.reset();
+        for (int id : joiners) ipfs.InsertMachine(id, order);
+        record(2, sw.elapsedMs());
+        if (blocks) phases[2].mb = (ipfs.C->blockStats().bytesHandedIn - handedIn) / MB;
+
+        handedIn = ipfs.C->blockStats().bytesHandedIn;
+        sw.reset();
+        for (int i = 0; i < churn; i++) ipfs.DeleteMachine(idList[static_cast<size_t>(i) * 3 % idList.size()], order);
+        record(3, sw.elapsedMs());
+        if (blocks) phases[3].mb = (ipfs.C->blockStats().bytesHandedIn - handedIn) / MB;
+
+        BlockStats before = ipfs.C->blockStats();
+        sw.reset();
+        for (size_t i = 0; i < files.size(); i += 2) ipfs.Delete(static_cast<int>(files[i]));
+        record(4, sw.elapsedMs());
+        if (blocks) {
+            afterDelete = ipfs.C->blockStats();
+            phases[4].mb = (afterDelete.bytesCompacted - before.bytesCompacted) / MB;
+            for (size_t i = 1; i < files.size(); i += 2) {
+                uint64_t key = files[i];
+                if (!ipfs.ReadData(static_cast<int>(key), data) ||
+                    data != BlockLog::payloadFor(static_cast<int>(key), fileSizeFor(key))) {
+                    corrupt++;
+                }
+            }
+        }
+    }
+
+    vector<int> widths = { 12, 13, 13, 10, 10 };
+    printRule(widths);
+    printRow({ "Phase", "Index ms", "Blocks ms", "MB", "MB/s" }, widths);
+    printRule(widths);
+    for (const Phase& p : phases) {
+        printRow({ p.name, fixedStr(p.indexMs, 1), fixedStr(p.blockMs, 1), fixedStr(p.mb, 1),
+                   p.blockMs > 0 ? fixedStr(p.mb / (p.blockMs / 1000), 0) : "-" }, widths);
+    }
+    printRule(widths);
+    cout << "  MB: written (Put), read (Read back), moved between machine logs (Joins, Leaves),\n";
+    cout << "  copied by compaction (Delete half). Index = B-trees only, no file bytes.\n\n";
+
+    cout << "  On disk after load:   " << fixedStr(afterLoad.diskBytes / MB, 1) << " MB\n";
+    cout << "  After deleting half:  " << fixedStr(afterDelete.diskBytes / MB, 1) << " MB ("
+         << fixedStr(afterDelete.deadBytes / MB, 1) << " MB dead), " << afterDelete.segmentsCompacted
+         << " segments compacted in total\n";
+    cout << "  Files read back wrong: " << corrupt << ", I/O errors: " << afterDelete.ioErrors << "\n";
+    return corrupt == 0 && afterDelete.ioErrors == 0 ? 0 : 1;
+}
@@ -0,0 +1,93 @@
+/**
+ * @file CoalesceBench.h
+ * @brief Flash crowd: lookups with and without single-flight coalescing
+ * @details Clients reach the ring through a few gateway machines. Requests
+ *          arrive in batches of W concurrent lookups; under a flash crowd most
+ *          of them ask for one hot key, the rest for stored keys picked
+ *          uniformly. Each batch goes through IPFS::SearchFiles() with
+ *          coalescing off and on. Reports routes and B-tree descents per request
+ *          and time per request.
+ *
+ * Compile: g++ -std=c++17 -O2 -Isrc -o ipfs_bench bench/bench_main.cpp
+ */
+
+#pragma once
+#include "BenchUtil.h"
+#include "IPFS.h"
+#include "RingFixture.h"
+
+/**
+ * @brief ipfs_bench coalesce [--machines=N] [--files=F] [--gateways=G] [--requests=R]
+ */
+inline int runCoalesceBench(int argc, char** argv) {
+    int machines = static_cast<int>(getOption(argc, argv, "machines", 4096));
+    int numFiles = static_cast<int>(getOption(argc, argv, "files", 100000));
+    int gateways = static_cast<int>(getOption(argc, argv, "gateways", 32));
+    int requests = static_cast<int>(getOption(argc, argv, "requests", 200000));
+    const int bits = 24;
+    const int order = 5;
+
+    printBenchHeader("REQUEST COALESCING: single flight at origin and owner");
+    cout << "  " << machines << " machines, " << numFiles << " files, " << gateways << " gateway machines, "
+         << requests << " lookups in batches of W concurrent requests.\n\n";
+
+    mt19937_64 rng(71);
+    vector<uint64_t> ids = uniqueRandomKeys(static_cast<size_t>(machines), bits, rng);
+    vector<int> idList(ids.begin(), ids.end());
+    vector<uint64_t> files = uniqueRandomKeys(static_cast<size_t>(numFiles), bits, rng);
+    IPFS ipfs(bits, order);
+    ipfs.SetVerbose(false);
+    ipfs.ApplyMembershipBatch(idList, {});
+    for (uint64_t key : files) ipfs.Put(static_cast<int>(key), "file_" + to_string(key), fileSizeFor(key));
+    vector<int> origins(idList.begin(), idList.begin() + min(gateways, machines));
+
+    vector<int> widths = { 10, 6, 11, 10, 11, 10, 10, 10 };
+    printRule(widths);
+    printRow({ "Workload", "W", "Routes/req", "Desc/req", "ns/req off", "ns/req on", "Work -%", "Speedup" },
+             widths);
+    printRule(widths);
+
+    for (double hotShare : { 0.0, 0.5, 0.9 }) {
+        int hotKey = static_cast<int>(files[0]);
+        for (int window : { 16, 64, 256, 1024 }) {
+            mt19937_64 pick(73);
+            vector<vector<LookupRequest>> batches;
+            for (int done = 0; done < requests; done += window) {
+                vector<LookupRequest> batch;
+                for (int i = 0; i < window; i++) {
+                    double u = static_cast<double>(pick() >> 11) / static_cast<double>(1ULL << 53);
+                    int key = u < hotShare ? hotKey : static_cast<int>(files[pick() % files.size()]);
+                    batch.push_back({ origins[pick() % origins.size()], key });
+                }
+                batches.push_back(batch);
+            }
+
+            double ns[2];
+            CoalesceStats stats[2];
+            long long found[2] = { 0, 0 };
+            for (int on = 0; on <= 1; on++) {
+                ipfs.SetCoalescing(on == 1);
+                Stopwatch sw;
+                for (const vector<LookupRequest>& batch : batches) {
+                    for (FileNode* file : ipfs.SearchFiles(batch, &stats[on])) found[on] += file != nullptr;
+                }
+                ns[on] = sw.elapsedNs() / static_cast<double>(stats[on].requests);
+            }
+            if (found[0] != found[1] || found[1] != stats[1].requests) {
+                cout << "  ERROR: coalesced lookups returned different results!\n";
+                return 1;
+            }
+            double req = static_cast<double>(stats[1].requests);
+            double workOff = static_cast<double>(stats[0].routes + stats[0].descents);
+            double workOn = static_cast<double>(stats[1].routes + stats[1].descents);
+            printRow({ window == 16 ? (hotShare > 0 ? fixedStr(100 * hotShare, 0) + "% hot" : "Uniform") : "",
+                       to_string(window), fixedStr(stats[1].routes / req, 3), fixedStr(stats[1].descents / req, 3),
+                       fixedStr(ns[0], 0), fixedStr(ns[1], 0), fixedStr(100.0 * (workOff - workOn) / workOff, 1),
+                       fixedStr(ns[0] / ns[1], 2) + "x" }, widths);
+        }
+        printRule(widths);
+    }
+    cout << "  Routes/req and Desc/req with coalescing on (both are 1.000 with it off).\n";
+    cout << "  Work -% = routes + descents saved; every request still gets its file.\n";
+    return 0;
+}
@@ -0,0 +1,184 @@
+/**
+ * @file ConcurrentBench.h
+ * @brief Concurrent membership benchmark: lock-free skip list vs mutex + std::set
+ * @details Threads run a mix of joins, leaves and succ queries on a shared
+ *          ring, then the final ring is checked for sorted traversal and the
+ *          exact expected membership. The same mix is then run on a real
+ *          CircularLinkedList: insertAfter()/deletekey() serialize on its
+ *          membership lock while successorId() stays lock-free.
+ * 
+ * Compile: g++ -std=c++17 -O2 -pthread -Isrc -o ipfs_bench bench/bench_main.cpp
+ */
+
+#pragma once
+#include <mutex>
+#include <set>
+#include <thread>
+#include "BenchUtil.h"
+#include "LockFreeSkipList.h"
+#include "RingFixture.h"
+
+/**
+ * @brief Baseline: ring membership behind a single mutex
+ */
+class LockedRing {
+public:
+    set<int> members;
+    mutable mutex lock;
+
+    bool join(int id) {
+        lock_guard<mutex> guard(lock);
+        return members.insert(id).second;
+    }
+
+    bool leave(int id) {
+        lock_guard<mutex> guard(lock);
+        return members.erase(id) > 0;
+    }
+
+    int succ(int key) const {
+        lock_guard<mutex> guard(lock);
+        if (members.empty()) return -1;
+        auto it = members.lower_bound(key);
+        return it == members.end() ? *members.begin() : *it;
+    }
+};
+
+/**
+ * @brief Run the same op mix on T threads; returns million ops per second
+ * @details Thread t owns IDs congruent to t mod T, so the expected final
+ *          membership is known: every owned ID joined, every 4th left again.
+ */
+template<typename Join, typename Leave, typename Succ>
+double runMembershipMix(int threads, int opsPerThread, int identifierSpace,
+                        Join join, Leave leave, Succ succ) {
+    vector<thread> workers;
+    Stopwatch sw;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([=]() {
+            uint64_t state = 0x2545F4914F6CDD1DULL * (t + 1);
+            uint64_t acc = 0;
+            int nextId = t;
+            for (int op = 0; op < opsPerThread; op++) {
+                state ^= state << 13;
+                state ^= state >> 7;
+                state ^= state << 17;
+                int kind = static_cast<int>(state % 10);
+                if (kind == 0 && nextId < identifierSpace) {
+                    join(nextId);
+                    if ((nextId / threads) % 4 == 3) leave(nextId);
+                    nextId += threads;
+                } else {
+                    acc += static_cast<uint64_t>(succ(static_cast<int>((state >> 20) % identifierSpace)));
+                }
+            }
+            benchSink = benchSink + acc;
+        });
+    }
+    for (thread& w : workers) w.join();
+    double seconds = sw.elapsedMs() / 1000.0;
+    return (static_cast<double>(threads) * opsPerThread) / seconds / 1e6;
+}
+
+/**
+ * @brief Machine IDs of the ring in list order
+ */
+inline vector<int> ringMachineIds(CircularLinkedList& ring) {
+    vector<int> ids;
+    CircularNode* current = ring.head;
+    if (current == nullptr) return ids;
+    do {
+        ids.push_back(current->key);
+        current = current->next;
+    } while (current != ring.head);
+    return ids;
+}
+
+/**
+ * @brief ipfs_bench concurrent [--threads=8] [--ops=200000] [--bits=24] [--ring-ops=2000]
+ */
+inline int runConcurrentBench(int argc, char** argv) {
+    int maxThreads = static_cast<int>(getOption(argc, argv, "threads", 8));
+    int ops = static_cast<int>(getOption(argc, argv, "ops", 200000));
+    int bits = static_cast<int>(getOption(argc, argv, "bits", 24));
+    int identifierSpace = 1 << bits;
+    int ringOps = static_cast<int>(getOption(argc, argv, "ring-ops", 2000));
+
+    printBenchHeader("CONCURRENT MEMBERSHIP: lock-free skip list vs mutex + std::set");
+    cout << "  " << ops << " ops per thread: 10% joins (1 in 4 followed by a leave), 90% succ.\n";
+    cout << "  Hardware threads available: " << thread::hardware_concurrency() << "\n\n";
+
+    vector<int> widths = { 8, 16, 16, 10, 18 };
+    printRule(widths);
+    printRow({ "Threads", "Lock-free Mops/s", "Mutex Mops/s", "Speedup", "Lock-free check" }, widths);
+    printRule(widths);
+
+    bool allOk = true;
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        ConcurrentRing<int> ring;
+        ring.join(identifierSpace - 1, identifierSpace - 1);   // Never empty
+        double lockFree = runMembershipMix(threads, ops, identifierSpace,
+            [&](int id) { ring.join(id, id); },
+            [&](int id) { ring.leave(id); },
+            [&](int key) { return ring.succ(key)->key; });
+
+        LockedRing locked;
+        locked.join(identifierSpace - 1);
+        double mutexed = runMembershipMix(threads, ops, identifierSpace,
+            [&](int id) { locked.join(id); },
+            [&](int id) { locked.leave(id); },
+            [&](int key) { return locked.succ(key); });
+
+        // Lock-free ring must match the mutex ring and traverse in sorted order
+        vector<int> traversal;
+        ring.forEachMachine([&](int64_t key, int) { traversal.push_back(static_cast<int>(key)); });
+        bool sorted = is_sorted(traversal.begin(), traversal.end()) &&
+                      adjacent_find(traversal.begin(), traversal.end()) == traversal.end();
+        bool sameSet = traversal.size() == locked.members.size() &&
+                       equal(traversal.begin(), traversal.end(), locked.members.begin());
+        bool ok = sorted && sameSet && ring.size() == traversal.size();
+        allOk = allOk && ok;
+        ring.reclaimRetired();
+
+        printRow({ to_string(threads), fixedStr(lockFree, 2), fixedStr(mutexed, 2),
+                   fixedStr(lockFree / mutexed, 2) + "x",
+                   ok ? ("OK (" + to_string(traversal.size()) + ")") : "MISMATCH" }, widths);
+    }
+    printRule(widths);
+
+    // Same mix on the real ring: joins and leaves rebuild fingers under the
+    // membership lock, lookups read the skip list without it
+    int ringSpace = 1 << 16;
+    cout << "\n  CircularLinkedList, " << ringOps << " ops per thread: insertAfter/deletekey vs successorId.\n\n";
+    vector<int> ringWidths = { 8, 12, 10, 22 };
+    printRule(ringWidths);
+    printRow({ "Threads", "Kops/s", "Machines", "Skip list == ring" }, ringWidths);
+    printRule(ringWidths);
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        CircularLinkedList ring(ringSpace, 5);
+        ring.verbose = false;
+        ring.insert(ringSpace - 1);                 // Never empty
+        ring.updateRT();
+        atomic<long long> misses(0);
+        double mops = runMembershipMix(threads, ringOps, ringSpace,
+            [&](int id) { ring.insertAfter(id, 5); },
+            [&](int id) { ring.deletekey(id, 5); },
+            [&](int key) {
+                int id = ring.successorId(key);
+                if (id < 0) misses++;
+                return id;
+            });
+
+        vector<int> listed = ringMachineIds(ring);
+        vector<int> skipped;
+        ring.members.forEachMachine([&](int64_t key, int) { skipped.push_back(static_cast<int>(key)); });
+        bool ok = misses.load() == 0 && listed == skipped && ring.nodeIndex.size() == listed.size();
+        allOk = allOk && ok;
+        ring.members.reclaimRetired();
+
+        printRow({ to_string(threads), fixedStr(mops * 1000.0, 1), to_string(listed.size()),
+                   ok ? "OK" : "MISMATCH" }, ringWidths);
+    }
+    printRule(ringWidths);
+    return allOk ? 0 : 1;
+}
@@ -0,0 +1,120 @@
+/**
+ * @file DrainBench.h
+ * @brief Decommission benchmark: blocking deletekey() vs graceful draining
+ * @details Runs a steady stream of file lookups in ticks while one heavily
+ *          loaded machine leaves. The blocking variant removes it inside one
+ *          tick; the graceful variant drains one chunk per tick. Reports the
+ *          per-tick latency distribution and lookups that missed their file.
+ *
+ * Compile: g++ -std=c++17 -O2 -Isrc -o ipfs_bench bench/bench_main.cpp
+ */
+
+#pragma once
+#include "BenchUtil.h"
+#include "RingFixture.h"
+
+/**
+ * @brief Per-tick latencies and lookup misses of one decommission run
+ */
+struct DrainRun {
+    vector<double> tickMs;
+    long long misses = 0;
+    int ticksUntilGone = 0;
+};
+
+/**
+ * @brief Run lookup ticks around the removal of victim
+ * @param chunk Files per tick for graceful draining; 0 = blocking deletekey()
+ */
+inline DrainRun runDecommission(CircularLinkedList* ring, int victim, const vector<uint64_t>& files,
+                                int lookupsPerTick, int chunk, int order, mt19937_64& rng) {
+    const int warmupTicks = 10;
+    const int cooldownTicks = 10;
+    DrainRun run;
+    int tick = 0;
+    int goneAt = -1;
+
+    while (goneAt < 0 || tick < goneAt + cooldownTicks) {
+        Stopwatch sw;
+        if (tick == warmupTicks) {
+            if (chunk == 0) {
+                ring->deletekey(victim, order);
+            } else {
+                ring->beginDrain(victim);
+            }
+        }
+        if (tick >= warmupTicks && chunk > 0) {
+            ring->drainStep(victim, chunk, order);
+        }
+        if (goneAt < 0 && tick >= warmupTicks && !ring->search(victim)) {
+            goneAt = tick;
+        }
+
+        for (int i = 0; i < lookupsPerTick; i++) {
+            int key = static_cast<int>(files[rng() % files.size()]);
+            if (ring->locateFile(ring->succ(key), key) == nullptr) run.misses++;
+        }
+        run.tickMs.push_back(sw.elapsedMs());
+        tick++;
+    }
+    run.ticksUntilGone = goneAt - warmupTicks + 1;
+    return run;
+}
+
+/**
+ * @brief ipfs_bench drain [--machines=N] [--files=F] [--chunk=C] [--lookups=L]
+ */
+inline int runDrainBench(int argc, char** argv) {
+    int machines = static_cast<int>(getOption(argc, argv, "machines", 16));
+    int numFiles = static_cast<int>(getOption(argc, argv, "files", 200000));
+    int chunk = static_cast<int>(getOption(argc, argv, "chunk", 256));
+    int lookups = static_cast<int>(getOption(argc, argv, "lookups", 2000));
+    const int bits = 24;
+    const int order = 5;
+
+    printBenchHeader("DECOMMISSION: blocking deletekey() vs graceful drain");
+    cout << "  " << machines << " machines, " << numFiles << " files, " << lookups
+         << " lookups per tick; the most loaded machine leaves.\n\n";
+
+    mt19937_64 rng(11);
+    vector<uint64_t> ids = uniqueRandomKeys(static_cast<size_t>(machines), bits, rng);
+    vector<uint64_t> files = uniqueRandomKeys(static_cast<size_t>(numFiles), bits, rng);
+
+    vector<int> widths = { 10, 10, 10, 10, 10, 10, 10 };
+    printRule(widths);
+    printRow({ "Mode", "Ticks", "p50 ms", "p99 ms", "Max ms", "Misses", "Placement" }, widths);
+    printRule(widths);
+
+    bool allOk = true;
+    for (int mode = 0; mode < 2; mode++) {
+        CircularLinkedList* ring = buildRing(bits, ids, files, order);
+
+        int victim = -1;
+        int mostFiles = -1;
+        CircularNode* current = ring->head;
+        do {
+            int count = current->BTreeroot.countFiles(current->BTreeroot.root);
+            if (count > mostFiles) {
+                mostFiles = count;
+                victim = current->key;
+            }
+            current = current->next;
+        } while (current != ring->head);
+
+        DrainRun run = runDecommission(ring, victim, files, lookups, mode == 0 ? 0 : chunk, order, rng);
+        bool placed = filesPlacedCorrectly(ring, files.size());
+        allOk = allOk && placed && run.misses == 0;
+
+        vector<double> sorted(run.tickMs);
+        sort(sorted.begin(), sorted.end());
+        double p50 = sorted[sorted.size() / 2];
+        double p99 = sorted[min(sorted.size() - 1, sorted.size() * 99 / 100)];
+
+        printRow({ mode == 0 ? "blocking" : "drain/" + to_string(chunk), to_string(run.ticksUntilGone),
+                   fixedStr(p50, 3), fixedStr(p99, 3), fixedStr(sorted.back(), 3),
+                   to_string(run.misses), placed ? "OK" : "MISMATCH" }, widths);
+        delete ring;
+    }
+    printRule(widths);
+    return allOk ? 0 : 1;
+}
@@ -0,0 +1,158 @@
+/**
+ * @file EngineBench.h
+ * @brief Placement engines: Chord ring vs jump consistent hash vs Maglev
+ * @details Each engine runs behind the same IPFS Put/Get/Delete API and
+ *          workload. Reports time per operation, routing hops, the fraction
+ *          of files that change machine per join and per leave (against the
+ *          1/N minimum), membership change time and file balance.
+ *
+ * Compile: g++ -std=c++17 -O2 -Isrc -o ipfs_bench bench/bench_main.cpp
+ */
+
+#pragma once
+#include <unordered_map>
+#include "BenchUtil.h"
+#include "IPFS.h"
+#include "Workload.h"
+
+/**
+ * @brief File key -> machine ID currently storing it
+ */
+inline unordered_map<int, int> snapshotHolders(CircularLinkedList* ring) {
+    unordered_map<int, int> holders;
+    CircularNode* current = ring->head;
+    do {
+        if (current->BTreeroot.root != nullptr) {
+            for (const FileNode& file : current->BTreeroot.getAllFiles(current->BTreeroot.root)) {
+                holders[file.key] = current->key;
+            }
+        }
+        current = current->next;
+    } while (current != ring->head);
+    return holders;
+}
+
+/**
+ * @brief Fraction of files stored on a different machine than before
+ */
+inline double movedFraction(const unordered_map<int, int>& before, const unordered_map<int, int>& after) {
+    size_t moved = 0;
+    for (const auto& entry : after) {
+        auto it = before.find(entry.first);
+        if (it != before.end() && it->second != entry.second) moved++;
+    }
+    return after.empty() ? 0.0 : static_cast<double>(moved) / static_cast<double>(after.size());
+}
+
+/**
+ * @brief ipfs_bench engine [--machines=N] [--files=F] [--churn=C] [--ops=K]
+ */
+inline int runEngineBench(int argc, char** argv) {
+    int machines = static_cast<int>(getOption(argc, argv, "machines", 64));
+    int numFiles = static_cast<int>(getOption(argc, argv, "files", 100000));
+    int churn = static_cast<int>(getOption(argc, argv, "churn", 16));
+    size_t ops = static_cast<size_t>(getOption(argc, argv, "ops", 200000));
+    const int bits = 24;
+    const int order = 5;
+
+    printBenchHeader("PLACEMENT ENGINES: Chord ring vs jump hash vs Maglev");
+    cout << "  " << machines << " machines, " << numFiles << " files; " << ops
+         << " ops (90% get, 5% put, 5% delete, Zipf 0.9),\n";
+    cout << "  then " << churn << " joins and " << churn << " leaves of random machines. "
+         << "Minimum move = 1/N = " << fixedStr(100.0 / machines, 2) << "%.\n\n";
+
+    mt19937_64 rng(23);
+    vector<uint64_t> ids = uniqueRandomKeys(static_cast<size_t>(machines + churn), bits, rng);
+    shuffle(ids.begin(), ids.end(), rng);
+    vector<int> initial(ids.begin(), ids.begin() + machines);
+    vector<int> joins(ids.begin() + machines, ids.end());
+    vector<uint64_t> files = uniqueRandomKeys(static_cast<size_t>(numFiles), bits, rng);
+
+    // Leaves pick random machines (not the newest), the worst case for jump hash
+    vector<int> leaves;
+    {
+        vector<int> pool(ids.begin(), ids.end());
+        shuffle(pool.begin(), pool.end(), rng);
+        leaves.assign(pool.begin(), pool.begin() + churn);
+    }
+
+    const PlacementMode modes[] = { PlacementMode::Ring, PlacementMode::Jump, PlacementMode::Maglev };
+    vector<int> widths = { 11, 9, 7, 9, 9, 10, 10, 9, 9 };
+    printRule(widths);
+    printRow({ "Engine", "ns/op", "Hops", "Join %", "Leave %", "Max mv %", "Change ms", "Max/mean", "Check" },
+             widths);
+    printRule(widths);
+
+    bool allOk = true;
+    for (PlacementMode mode : modes) {
+        IPFS ipfs(bits, order);
+        ipfs.SetVerbose(false);
+        ipfs.SetPlacement(mode);
+        ipfs.ApplyMembershipBatch(initial, {});
+        for (uint64_t key : files) {
+            ipfs.Put(static_cast<int>(key), "file_" + to_string(key), fileSizeFor(key));
+        }
+
+        Workload workload(files, bits, 0.05, 0.05, 0.9, 29);
+        WorkloadStats stats = runWorkload(ipfs, workload, ops);
+
+        // Routing hops from random starting machines
+        mt19937_64 hopRng(31);
+        double hops = 0;
+        const int hopSamples = 2000;
+        for (int i = 0; i < hopSamples; i++) {
+            int start = initial[hopRng() % initial.size()];
+            int key = static_cast<int>(files[hopRng() % files.size()]);
+            hops += static_cast<double>(ipfs.C->routeToKey(start, key).size() - 1);
+        }
+        hops /= hopSamples;
+
+        // Membership churn, one change at a time
+        double joinMoved = 0, leaveMoved = 0, maxMoved = 0, changeMs = 0;
+        unordered_map<int, int> before = snapshotHolders(ipfs.C);
+        for (int i = 0; i < 2 * churn; i++) {
+            Stopwatch sw;
+            if (i < churn) {
+                ipfs.InsertMachine(joins[static_cast<size_t>(i)], order);
+            } else {
+                ipfs.DeleteMachine(leaves[static_cast<size_t>(i - churn)], order);
+            }
+            changeMs += sw.elapsedMs();
+            unordered_map<int, int> after = snapshotHolders(ipfs.C);
+            double moved = movedFraction(before, after);
+            (i < churn ? joinMoved : leaveMoved) += moved;
+            maxMoved = max(maxMoved, moved);
+            before.swap(after);
+        }
+
+        // Every file on its owner, none lost, and the per-machine spread
+        bool placed = stats.misses == 0;
+        double peak = 0;
+        size_t total = 0;
+        CircularNode* current = ipfs.C->head;
+        do {
+            size_t count = 0;
+            if (current->BTreeroot.root != nullptr) {
+                for (const FileNode& file : current->BTreeroot.getAllFiles(current->BTreeroot.root)) {
+                    if (ipfs.C->ownerOf(file.key) != current) placed = false;
+                    count++;
+                }
+            }
+            peak = max(peak, static_cast<double>(count));
+            total += count;
+            current = current->next;
+        } while (current != ipfs.C->head);
+        placed = placed && total == workload.live.size();
+        allOk = allOk && placed;
+        double mean = static_cast<double>(total) / ipfs.getMachineCount();
+
+        printRow({ ipfs.C->placement.name(),
+                   fixedStr(stats.nsPerOp(), 0), fixedStr(hops, 2),
+                   fixedStr(100.0 * joinMoved / churn, 2), fixedStr(100.0 * leaveMoved / churn, 2),
+                   fixedStr(100.0 * maxMoved, 2), fixedStr(changeMs / (2 * churn), 2),
+                   fixedStr(mean > 0 ? peak / mean : 0, 2), placed ? "OK" : "MISMATCH" }, widths);
+    }
+    printRule(widths);
+    cout << "  Join/Leave % = average share of files that changed machine per membership change.\n";
+    return allOk ? 0 : 1;
+}
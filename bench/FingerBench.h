@@ -0,0 +1,91 @@
+/**
+ * @file FingerBench.h
+ * @brief Chord finger base k: hop count vs finger table size
+ * @details Lays fingers out at n + j*k^i for k = 2, 4, 8, 16 on rings of
+ *          increasing size and routes random keys from random machines.
+ *          Reports hops, fingers and bytes per machine, routing state of the
+ *          whole ring and time per lookup, so k can be picked per deployment.
+ *          A second table shows finger deduplication on sparse rings: the
+ *          finger targets laid out (O(bits)) vs the distinct entries stored
+ *          and scanned (O(log N)).
+ *
+ * Compile: g++ -std=c++17 -O2 -Isrc -o ipfs_bench bench/bench_main.cpp
+ */
+
+#pragma once
+#include "BenchUtil.h"
+#include "IPFS.h"
+#include "RoutingBench.h"
+
+/**
+ * @brief ipfs_bench fingers [--max=N] [--lookups=L]
+ */
+inline int runFingerBench(int argc, char** argv) {
+    int maxMachines = static_cast<int>(getOption(argc, argv, "max", 65536));
+    int lookups = static_cast<int>(getOption(argc, argv, "lookups", 20000));
+    const int bits = 24;
+    const int order = 5;
+
+    printBenchHeader("FINGER BASE: hops vs finger table size");
+    cout << "  " << bits << "-bit IDs, fingers at n + j*k^i (1 <= j < k), " << lookups
+         << " lookups of random keys from random machines.\n\n";
+
+    vector<int> widths = { 9, 6, 9, 9, 9, 9, 11, 10, 10 };
+    printRule(widths);
+    printRow({ "Machines", "k", "Avg hops", "Max hops", "Targets", "Stored", "Bytes/node", "Ring KB", "ns/lookup" },
+             widths);
+    printRule(widths);
+
+    mt19937_64 rng(43);
+    for (int n = 256; n <= maxMachines; n *= 4) {
+        vector<uint64_t> keys = uniqueRandomKeys(static_cast<size_t>(n), bits, rng);
+        vector<int> ids(keys.begin(), keys.end());
+        IPFS ipfs(bits, order);
+        ipfs.SetVerbose(false);
+        ipfs.ApplyMembershipBatch(ids, {});
+        CircularLinkedList* ring = ipfs.C;
+
+        for (int k : { 2, 4, 8, 16 }) {
+            ipfs.SetFingerBase(k);
+            int maxHops;
+            double ns;
+            double hops = measureRouting(ring, ids, lookups, rng, maxHops, ns);
+            double entries, bytes;
+            routingState(ring, entries, bytes);
+            printRow({ k == 2 ? to_string(n) : "", to_string(k), fixedStr(hops, 2), to_string(maxHops),
+                       to_string(ring->head->RT.targets()), fixedStr(entries, 1), fixedStr(bytes, 0), fixedStr(bytes * n / 1024.0, 0),
+                       fixedStr(ns, 0) }, widths);
+        }
+        printRule(widths);
+    }
+    cout << "  Hops fall as log_k N while targets grow as (k-1) * log_k 2^" << bits << ".\n";
+    cout << "  Stored = distinct entries after merging runs that resolve to the same machine (ring average).\n\n";
+
+    // Deduplication on sparse rings: stored entries track log N, not bits
+    vector<int> sparseWidths = { 6, 9, 9, 9, 13, 11 };
+    cout << "  Finger deduplication on sparse rings (k = 2):\n";
+    printRule(sparseWidths);
+    printRow({ "Bits", "Machines", "Targets", "Stored", "Saved bytes", "ns/lookup" }, sparseWidths);
+    printRule(sparseWidths);
+    for (int sparseBits : { 16, 24, 30 }) {
+        for (int n : { 256, 4096 }) {
+            vector<uint64_t> keys = uniqueRandomKeys(static_cast<size_t>(n), sparseBits, rng);
+            vector<int> ids(keys.begin(), keys.end());
+            IPFS ipfs(sparseBits, order);
+            ipfs.SetVerbose(false);
+            if (sparseBits > OccupancyBitmap::AUTO_BITS) ipfs.EnableSuccessorTrie();
+            ipfs.ApplyMembershipBatch(ids, {});
+            CircularLinkedList* ring = ipfs.C;
+            int maxHops;
+            double ns;
+            measureRouting(ring, ids, lookups, rng, maxHops, ns);
+            double entries, bytes;
+            routingState(ring, entries, bytes);
+            double saved = (sparseBits - entries) * sizeof(DoublyNode<CircularNode>);
+            printRow({ n == 256 ? to_string(sparseBits) : "", to_string(n), to_string(sparseBits),
+                       fixedStr(entries, 1), fixedStr(saved, 0), fixedStr(ns, 0) }, sparseWidths);
+        }
+    }
+    printRule(sparseWidths);
+    return 0;
+}
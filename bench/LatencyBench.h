@@ -0,0 +1,151 @@
+/**
+ * @file LatencyBench.h
+ * @brief Tail latency of single, parallel (alpha) and hedged lookups, recursive vs iterative
+ * @details Routes random keys from random machines on a Chord ring with
+ *          one successor replica per file and charges every message with
+ *          LatencyModel (2% slow machines, rare spikes). Reports latency
+ *          percentiles and messages per lookup for each strategy; hedged
+ *          requests fire at the p95 (or p90) of single lookups, measured on a
+ *          separate warm-up sample. A second table replays single lookups
+ *          recursively and iteratively as the propagation across the
+ *          network grows from one data centre to a wide-area spread.
+ *
+ * Compile: g++ -std=c++17 -O2 -Isrc -o ipfs_bench bench/bench_main.cpp
+ */
+
+#pragma once
+#include "BenchUtil.h"
+#include "IPFS.h"
+#include "LatencySimulator.h"
+
+/**
+ * @brief One lookup strategy in the comparison
+ */
+struct LatencyStrategy {
+    string name;
+    LookupMode mode;
+    int alpha;
+    double hedgeQuantile;   // Hedged: fire at this quantile of single lookups
+};
+
+/**
+ * @brief Recursive vs iterative single lookups for a few network spreads
+ */
+inline void printLookupStyles(CircularLinkedList* ring, const vector<pair<int, int>>& queries) {
+    struct Spread {
+        string name;
+        double spanUs;
+    };
+    vector<Spread> spreads = { { "One DC", 0 }, { "Region", 2000 }, { "WAN", 40000 } };
+
+    cout << "\n  Lookup style: recursive (hops forward, owner answers) vs iterative (origin asks each hop).\n\n";
+    vector<int> widths = { 9, 10, 9, 9, 9, 10 };
+    printRule(widths);
+    printRow({ "Spread", "Style", "p50 ms", "p99 ms", "p999 ms", "Msgs/look" }, widths);
+    printRule(widths);
+    for (const Spread& spread : spreads) {
+        for (LookupStyle style : { LookupStyle::Recursive, LookupStyle::Iterative }) {
+            LatencyModel model(67, LatencyModel::DEFAULT_MEDIAN_US, spread.spanUs);
+            LookupSimulator sim(ring, model, style);
+            vector<double> us;
+            long long messages = 0;
+            for (const auto& q : queries) {
+                LookupCost cost = sim.lookup(q.first, q.second, LookupMode::Single);
+                us.push_back(cost.latencyUs);
+                messages += cost.messages;
+            }
+            printRow({ style == LookupStyle::Recursive ? spread.name : "",
+                       style == LookupStyle::Recursive ? "Recursive" : "Iterative",
+                       fixedStr(percentile(us, 0.50) / 1000, 2), fixedStr(percentile(us, 0.99) / 1000, 2),
+                       fixedStr(percentile(us, 0.999) / 1000, 2),
+                       fixedStr(static_cast<double>(messages) / queries.size(), 2) }, widths);
+        }
+        printRule(widths);
+    }
+    cout << "  Spread = one-way propagation between the two farthest machines (0, 2 ms, 40 ms).\n";
+}
+
+/**
+ * @brief ipfs_bench latency [--machines=N] [--lookups=L]
+ */
+inline int runLatencyBench(int argc, char** argv) {
+    int machines = static_cast<int>(getOption(argc, argv, "machines", 4096));
+    int lookups = static_cast<int>(getOption(argc, argv, "lookups", 100000));
+    const int bits = 24;
+    const int order = 5;
+
+    printBenchHeader("TAIL LATENCY: single vs parallel vs hedged, recursive vs iterative");
+    cout << "  " << machines << " machines, " << lookups << " lookups; median message "
+         << fixedStr(LatencyModel::DEFAULT_MEDIAN_US, 0) << " us, "
+         << fixedStr(100 * LatencyModel::SLOW_MACHINE_SHARE, 0) << "% machines " << fixedStr(LatencyModel::SLOW_FACTOR, 0)
+         << "x slow, " << fixedStr(100 * LatencyModel::SPIKE_CHANCE, 1) << "% messages "
+         << fixedStr(LatencyModel::SPIKE_FACTOR, 0) << "x spikes.\n\n";
+
+    mt19937_64 rng(59);
+    vector<uint64_t> ids = uniqueRandomKeys(static_cast<size_t>(machines), bits, rng);
+    vector<int> idList(ids.begin(), ids.end());
+    IPFS ipfs(bits, order);
+    ipfs.SetVerbose(false);
+    ipfs.EnableReplication(ReplicaMode::SuccessorList, 2);
+    ipfs.ApplyMembershipBatch(idList, {});
+    CircularLinkedList* ring = ipfs.C;
+
+    vector<pair<int, int>> queries;
+    for (int i = 0; i < lookups; i++) {
+        queries.push_back({ idList[rng() % idList.size()], static_cast<int>(rng() & ((1ULL << bits) - 1)) });
+    }
+
+    // Hedge delays come from a separate sample of single lookups
+    LatencyModel warmModel(61);
+    LookupSimulator warm(ring, warmModel);
+    vector<double> warmUs;
+    for (int i = 0; i < min(lookups, 20000); i++) {
+        warmUs.push_back(warm.lookup(idList[rng() % idList.size()], static_cast<int>(rng() & ((1ULL << bits) - 1)),
+                                     LookupMode::Single).latencyUs);
+    }
+
+    vector<LatencyStrategy> strategies = {
+        { "Single", LookupMode::Single, 1, 0 },
+        { "Parallel a=2", LookupMode::Parallel, 2, 0 },
+        { "Parallel a=3", LookupMode::Parallel, 3, 0 },
+        { "Hedged p95", LookupMode::Hedged, 1, 0.95 },
+        { "Hedged p90", LookupMode::Hedged, 1, 0.90 },
+    };
+
+    vector<int> widths = { 13, 9, 9, 9, 10, 9, 9, 9 };
+    printRule(widths);
+    printRow({ "Strategy", "p50 ms", "p99 ms", "p999 ms", "Msgs/look", "Extra %", "p99 -%", "p999 -%" }, widths);
+    printRule(widths);
+
+    double baseMessages = 0, baseP99 = 0, baseP999 = 0;
+    for (const LatencyStrategy& strategy : strategies) {
+        LatencyModel model(67);     // Same message draws for every strategy
+        LookupSimulator sim(ring, model);
+        double hedgeAfter = strategy.hedgeQuantile > 0 ? percentile(warmUs, strategy.hedgeQuantile) : 0;
+        vector<double> us;
+        long long messages = 0;
+        for (const auto& q : queries) {
+            LookupCost cost = sim.lookup(q.first, q.second, strategy.mode, strategy.alpha, hedgeAfter);
+            us.push_back(cost.latencyUs);
+            messages += cost.messages;
+        }
+        double perLookup = static_cast<double>(messages) / lookups;
+        double p99 = percentile(us, 0.99), p999 = percentile(us, 0.999);
+        if (strategy.mode == LookupMode::Single) {
+            baseMessages = perLookup;
+            baseP99 = p99;
+            baseP999 = p999;
+        }
+        printRow({ strategy.name, fixedStr(percentile(us, 0.50) / 1000, 2), fixedStr(p99 / 1000, 2),
+                   fixedStr(p999 / 1000, 2), fixedStr(perLookup, 2),
+                   fixedStr(100.0 * (perLookup - baseMessages) / baseMessages, 1),
+                   fixedStr(100.0 * (baseP99 - p99) / baseP99, 1),
+                   fixedStr(100.0 * (baseP999 - p999) / baseP999, 1) }, widths);
+    }
+    printRule(widths);
+    cout << "  Extra % = messages beyond single lookups; p99/p999 -% = tail reduction against single.\n";
+    cout << "  Hedged requests go to the successor replica holder.\n";
+
+    printLookupStyles(ring, queries);
+    return 0;
+}
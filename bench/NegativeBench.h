@@ -0,0 +1,115 @@
+/**
+ * @file NegativeBench.h
+ * @brief Miss-heavy retry storm with and without origin negative caches
+ * @details Clients behind a few gateway machines keep asking for a pool of
+ *          keys that do not exist, mixed with lookups of stored files, and
+ *          retry every "not found" a few times with backoff. Some
+ *          missing keys get inserted along the way and a few machines join
+ *          halfway through, so cached misses must be invalidated by inserts
+ *          and by the membership epoch. Every budget replays the same
+ *          operations and must return the same answers as the run without a
+ *          cache. Reports routes per lookup, share of lookups answered at
+ *          the origin and time per lookup.
+ *
+ * Compile: g++ -std=c++17 -O2 -Isrc -o ipfs_bench bench/bench_main.cpp
+ */
+
+#pragma once
+#include "BenchUtil.h"
+#include "IPFS.h"
+#include "RingFixture.h"
+
+/**
+ * @brief ipfs_bench negative [--machines=N] [--files=F] [--missing=M] [--requests=R]
+ */
+inline int runNegativeBench(int argc, char** argv) {
+    int machines = static_cast<int>(getOption(argc, argv, "machines", 4096));
+    int numFiles = static_cast<int>(getOption(argc, argv, "files", 100000));
+    int numMissing = static_cast<int>(getOption(argc, argv, "missing", 2000));
+    int requests = static_cast<int>(getOption(argc, argv, "requests", 200000));
+    const int gateways = 64;
+    const int batchSize = 64;
+    const int bits = 24;
+    const int order = 5;
+
+    printBenchHeader("NEGATIVE CACHE: repeated lookups of missing keys");
+    cout << "  " << machines << " machines, " << numFiles << " files, " << gateways << " gateways; "
+         << requests << " client lookups, 30% for " << numMissing << " missing keys, each miss retried 4 times.\n";
+    cout << "  One missing key inserted every 1000 lookups; 16 machines join halfway.\n\n";
+
+    mt19937_64 rng(101);
+    vector<uint64_t> all = uniqueRandomKeys(static_cast<size_t>(machines + 16 + numFiles + numMissing), bits, rng);
+    shuffle(all.begin(), all.end(), rng);
+    vector<int> idList(all.begin(), all.begin() + machines);
+    vector<int> joiners(all.begin() + machines, all.begin() + machines + 16);
+    vector<uint64_t> files(all.begin() + machines + 16, all.begin() + machines + 16 + numFiles);
+    vector<int> missing(all.begin() + machines + 16 + numFiles, all.end());
+
+    // Lookup batches. A client that gets "not found" retries the same key from
+    // the same gateway after 1, 2, 4 and 8 batches.
+    mt19937_64 pick(103);
+    const vector<size_t> backoff = { 1, 2, 4, 8 };
+    size_t batchCount = static_cast<size_t>((requests + batchSize - 1) / batchSize);
+    vector<vector<LookupRequest>> batches(batchCount);
+    for (size_t b = 0; b < batchCount; b++) {
+        while (batches[b].size() < static_cast<size_t>(batchSize)) {
+            bool miss = pick() % 10 < 3;
+            int key = miss ? missing[pick() % missing.size()] : static_cast<int>(files[pick() % files.size()]);
+            LookupRequest request = { idList[pick() % gateways], key };
+            batches[b].push_back(request);
+            for (size_t delay : backoff) {
+                if (miss && b + delay < batchCount) batches[b + delay].push_back(request);
+            }
+        }
+    }
+    size_t joinBatch = batches.size() / 2;
+
+    vector<int> widths = { 8, 11, 10, 10, 10, 10 };
+    printRule(widths);
+    printRow({ "Slots", "Routes/req", "Cached %", "Saved %", "ns/req", "Same ans." }, widths);
+    printRule(widths);
+
+    vector<bool> reference;
+    double baseRoutes = 0;
+    for (int slots : { 0, 64, 256, 1024 }) {
+        IPFS ipfs(bits, order);
+        ipfs.SetVerbose(false);
+        ipfs.ApplyMembershipBatch(idList, {});
+        for (uint64_t key : files) ipfs.Put(static_cast<int>(key), "file_" + to_string(key), fileSizeFor(key));
+        ipfs.SetCoalescing(false);
+        ipfs.SetNegativeCache(slots);
+
+        CoalesceStats stats;
+        vector<bool> answers;
+        size_t inserted = 0;
+        double ns = 0;
+        for (size_t b = 0; b < batches.size(); b++) {
+            if (b == joinBatch) ipfs.ApplyMembershipBatch(joiners, {});
+            while (inserted < static_cast<size_t>(stats.requests) / 1000 && inserted < missing.size()) {
+                ipfs.Put(missing[inserted], "late_" + to_string(missing[inserted]));
+                inserted++;
+            }
+            Stopwatch sw;
+            vector<FileNode*> found = ipfs.SearchFiles(batches[b], &stats);
+            ns += sw.elapsedNs();
+            for (FileNode* file : found) answers.push_back(file != nullptr);
+        }
+        if (slots == 0) {
+            reference = answers;
+            baseRoutes = static_cast<double>(stats.routes);
+        }
+        double req = static_cast<double>(stats.requests);
+        printRow({ to_string(slots), fixedStr(stats.routes / req, 3), fixedStr(100.0 * stats.cachedMisses / req, 1),
+                   fixedStr(100.0 * (baseRoutes - stats.routes) / baseRoutes, 1), fixedStr(ns / req, 0),
+                   answers == reference ? "yes" : "NO" }, widths);
+        if (answers != reference) {
+            printRule(widths);
+            cout << "  ERROR: cached misses changed lookup answers!\n";
+            return 1;
+        }
+    }
+    printRule(widths);
+    cout << "  Slots = cached misses per origin machine. Cached % = lookups answered \"not found\" at the\n";
+    cout << "  origin without routing. Same ans. = every answer matches the run without a cache.\n";
+    return 0;
+}
@@ -0,0 +1,134 @@
+/**
+ * @file PlacementBench.h
+ * @brief Join placement benchmark: random IDs vs splitting the most loaded arc
+ * @details Files cluster in one region of the key space and requests in
+ *          another. Machines join one at a time using each placement policy;
+ *          after several join counts the max/mean ratio of key-space arc,
+ *          file count and request load shows how fast each policy balances.
+ *
+ * Compile: g++ -std=c++17 -O2 -Isrc -o ipfs_bench bench/bench_main.cpp
+ */
+
+#pragma once
+#include "BenchUtil.h"
+#include "RingFixture.h"
+
+/**
+ * @brief max/mean of arc size, files and request hits over all machines
+ */
+inline void measureImbalance(CircularLinkedList* ring, double& arcRatio, double& fileRatio, double& reqRatio) {
+    vector<double> arcs, fileLoad, reqLoad;
+    CircularNode* pred = ring->head;
+    while (pred->next != ring->head) pred = pred->next;
+    CircularNode* current = ring->head;
+    do {
+        arcs.push_back(static_cast<double>(ring->arcLength(pred, current)));
+        double files = 0, hits = 0;
+        if (current->BTreeroot.root != nullptr) {
+            for (const FileNode& file : current->BTreeroot.getAllFiles(current->BTreeroot.root)) {
+                files += 1;
+                hits += static_cast<double>(file.hits);
+            }
+        }
+        fileLoad.push_back(files);
+        reqLoad.push_back(hits);
+        pred = current;
+        current = current->next;
+    } while (current != ring->head);
+
+    auto ratio = [](const vector<double>& v) {
+        double sum = 0, peak = 0;
+        for (double x : v) {
+            sum += x;
+            peak = max(peak, x);
+        }
+        return sum > 0 ? peak / (sum / v.size()) : 0.0;
+    };
+    arcRatio = ratio(arcs);
+    fileRatio = ratio(fileLoad);
+    reqRatio = ratio(reqLoad);
+}
+
+/**
+ * @brief ipfs_bench placement [--machines=N] [--joins=J] [--files=F]
+ */
+inline int runPlacementBench(int argc, char** argv) {
+    int machines = static_cast<int>(getOption(argc, argv, "machines", 8));
+    int numJoins = static_cast<int>(getOption(argc, argv, "joins", 56));
+    int numFiles = static_cast<int>(getOption(argc, argv, "files", 100000));
+    const int bits = 24;
+    const int order = 5;
+    const int space = 1 << bits;
+
+    printBenchHeader("JOIN PLACEMENT: random IDs vs splitting the most loaded arc");
+    cout << "  " << machines << " random machines, " << numFiles << " files (half of them in 1/32 of\n";
+    cout << "  the key space), requests 50x hotter in another 1/16. Values are max/mean.\n\n";
+
+    mt19937_64 rng(3);
+    vector<uint64_t> initial = uniqueRandomKeys(static_cast<size_t>(machines), bits, rng);
+
+    // Skewed file keys: half uniform, half packed into [space/2, space/2 + space/32)
+    set<uint64_t> keySet;
+    while (keySet.size() < static_cast<size_t>(numFiles)) {
+        uint64_t key = (keySet.size() % 2 == 0) ? rng() % space : space / 2 + rng() % (space / 32);
+        keySet.insert(key);
+    }
+    vector<uint64_t> files(keySet.begin(), keySet.end());
+    auto hitsFor = [&](uint64_t key) -> long long {
+        return (key >= static_cast<uint64_t>(space / 8) && key < static_cast<uint64_t>(3 * space / 16)) ? 50 : 1;
+    };
+
+    struct Policy {
+        const char* name;
+        int metric;     // -1 = random ID
+    };
+    const Policy policies[] = {
+        { "random", -1 },
+        { "key space", static_cast<int>(LoadMetric::KeySpace) },
+        { "files", static_cast<int>(LoadMetric::Files) },
+        { "requests", static_cast<int>(LoadMetric::Requests) },
+    };
+
+    vector<int> widths = { 10, 7, 10, 10, 10 };
+    printRule(widths);
+    printRow({ "Policy", "Joins", "Arc", "Files", "Requests" }, widths);
+    printRule(widths);
+
+    for (const Policy& policy : policies) {
+        CircularLinkedList* ring = buildRing(bits, initial, files, order);
+        CircularNode* current = ring->head;
+        do {
+            if (current->BTreeroot.root != nullptr) {
+                for (const FileNode& file : current->BTreeroot.getAllFiles(current->BTreeroot.root)) {
+                    current->BTreeroot.findFile(file.key)->hits = hitsFor(static_cast<uint64_t>(file.key));
+                }
+            }
+            current = current->next;
+        } while (current != ring->head);
+
+        mt19937_64 joinRng(17);
+        for (int joined = 0; joined <= numJoins; joined++) {
+            if (joined == 0 || joined == 8 || joined == 24 || joined == numJoins) {
+                double arc, fileRatio, reqRatio;
+                measureImbalance(ring, arc, fileRatio, reqRatio);
+                printRow({ joined == 0 ? policy.name : "", to_string(joined), fixedStr(arc, 2),
+                           fixedStr(fileRatio, 2), fixedStr(reqRatio, 2) }, widths);
+            }
+            if (joined == numJoins) break;
+
+            int id;
+            if (policy.metric < 0) {
+                do {
+                    id = static_cast<int>(joinRng() % space);
+                } while (ring->search(id));
+            } else {
+                id = ring->proposeJoinId(static_cast<LoadMetric>(policy.metric)).id;
+                if (id < 0) break;
+            }
+            ring->insertAfter(id, order);
+        }
+        printRule(widths);
+        delete ring;
+    }
+    return 0;
+}
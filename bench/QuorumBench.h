@@ -0,0 +1,125 @@
+/**
+ * @file QuorumBench.h
+ * @brief N/R/W quorum settings: latency, availability and staleness
+ * @details N = 3 successor-list replicas. A share of the machines is
+ *          unreachable at any time and the failed set churns; recovered
+ *          machines receive their hints (sloppy quorum only). The same mix
+ *          of puts and Zipf-popular gets runs under each R/W setting with a
+ *          strict and a sloppy quorum. Reports get and put latency
+ *          percentiles, the share of operations that reached their quorum
+ *          and the share of successful gets that returned an older version
+ *          than the last acknowledged put.
+ *
+ * Compile: g++ -std=c++17 -O2 -Isrc -o ipfs_bench bench/bench_main.cpp
+ */
+
+#pragma once
+#include "BenchUtil.h"
+#include "IPFS.h"
+#include "QuorumStore.h"
+#include "Workload.h"
+
+/**
+ * @brief ipfs_bench quorum [--machines=N] [--keys=K] [--ops=O] [--down=PCT]
+ */
+inline int runQuorumBench(int argc, char** argv) {
+    int machines = static_cast<int>(getOption(argc, argv, "machines", 512));
+    int numKeys = static_cast<int>(getOption(argc, argv, "keys", 20000));
+    int ops = static_cast<int>(getOption(argc, argv, "ops", 100000));
+    double downShare = getOption(argc, argv, "down", 5) / 100.0;
+    const int bits = 24;
+    const int order = 5;
+    const int replication = 3;
+    const int churnEvery = 2000;    // Ops between failure changes
+
+    printBenchHeader("QUORUMS: tunable N/R/W with strict and sloppy quorums");
+    cout << "  " << machines << " machines, N = " << replication << " successor replicas, " << numKeys
+         << " keys; " << ops << " ops (50% puts, Zipf 0.9 keys);\n";
+    cout << "  " << fixedStr(100 * downShare, 0) << "% of machines unreachable, a quarter of them replaced every "
+         << churnEvery << " ops.\n\n";
+
+    mt19937_64 rng(107);
+    vector<uint64_t> ids = uniqueRandomKeys(static_cast<size_t>(machines), bits, rng);
+    vector<int> idList(ids.begin(), ids.end());
+    vector<uint64_t> keys = uniqueRandomKeys(static_cast<size_t>(numKeys), bits, rng);
+
+    vector<int> widths = { 5, 7, 9, 9, 9, 9, 9, 9, 9 };
+    printRule(widths);
+    printRow({ "R/W", "Quorum", "Get p50", "Get p99", "Put p50", "Put p99", "Get ok %", "Put ok %", "Stale %" },
+             widths);
+    printRule(widths);
+
+    vector<pair<int, int>> settings = { { 1, 1 }, { 1, 3 }, { 2, 2 }, { 3, 1 }, { 3, 3 } };
+    for (const pair<int, int>& rw : settings) {
+        for (bool sloppy : { false, true }) {
+            IPFS ipfs(bits, order);
+            ipfs.SetVerbose(false);
+            ipfs.EnableReplication(ReplicaMode::SuccessorList, replication);
+            ipfs.ApplyMembershipBatch(idList, {});
+            LatencyModel model(109);
+            QuorumStore store(ipfs.C, model, rw.first, rw.second, sloppy);
+
+            // Load every key with all machines up
+            unordered_map<int, long long> acked;    // Key -> last acknowledged version
+            for (uint64_t key : keys) {
+                int k = static_cast<int>(key);
+                acked[k] = store.put(idList[0], k, "file_" + to_string(k)).version;
+            }
+
+            // Same failures and operations for every setting
+            mt19937_64 opRng(113);
+            Workload workload(keys, bits, 0.0, 0.0, 0.9, 127);
+            vector<int> failed;
+            size_t target = static_cast<size_t>(downShare * machines);
+            vector<double> getUs, putUs;
+            long long getOk = 0, putOk = 0, gets = 0, puts = 0, stale = 0;
+            for (int op = 0; op < ops; op++) {
+                if (op % churnEvery == 0) {
+                    size_t replaced = failed.size() / 4;
+                    for (size_t i = 0; i < replaced; i++) {
+                        size_t j = static_cast<size_t>(opRng() % failed.size());
+                        store.recover(failed[j]);
+                        failed[j] = failed.back();
+                        failed.pop_back();
+                    }
+                    while (failed.size() < target) {
+                        int id = idList[opRng() % idList.size()];
+                        if (!store.isUp(id)) continue;
+                        store.fail(id);
+                        failed.push_back(id);
+                    }
+                }
+                int origin = idList[opRng() % idList.size()];
+                int key = workload.next().key;
+                if (opRng() % 2 == 0) {
+                    puts++;
+                    QuorumResult r = store.put(origin, key, "file_" + to_string(key) + "_v" + to_string(op));
+                    if (r.ok) {
+                        putOk++;
+                        putUs.push_back(r.latencyUs);
+                        acked[key] = r.version;
+                    }
+                } else {
+                    gets++;
+                    QuorumResult r = store.get(origin, key);
+                    if (r.ok) {
+                        getOk++;
+                        getUs.push_back(r.latencyUs);
+                        if (r.version < acked[key]) stale++;
+                    }
+                }
+            }
+
+            printRow({ sloppy ? "" : to_string(rw.first) + "/" + to_string(rw.second), sloppy ? "Sloppy" : "Strict",
+                       fixedStr(percentile(getUs, 0.50) / 1000, 2), fixedStr(percentile(getUs, 0.99) / 1000, 2),
+                       fixedStr(percentile(putUs, 0.50) / 1000, 2), fixedStr(percentile(putUs, 0.99) / 1000, 2),
+                       fixedStr(100.0 * getOk / gets, 2), fixedStr(100.0 * putOk / puts, 2),
+                       fixedStr(getOk > 0 ? 100.0 * stale / getOk : 0, 2) }, widths);
+        }
+        printRule(widths);
+    }
+    cout << "  Latencies in ms (round trips from the client's machine). Stale % = successful gets that\n";
+    cout << "  returned an older version than the last acknowledged put. R + W > N reads see every\n";
+    cout << "  acknowledged write as long as the quorum members are the true replicas.\n";
+    return 0;
+}
@@ -0,0 +1,179 @@
+/**
+ * @file RebalanceBench.h
+ * @brief Scale-out benchmark: synchronous handoff vs throttled background rebalancer
+ * @details A ring serves skewed lookups (most requests hit one hot slice of
+ *          the key space) in 1 ms ticks of simulated time while machines
+ *          join, one per tick. Synchronous joins move their files inside the
+ *          join tick; the rebalancer moves files under a files/sec or
+ *          bytes/sec budget. Reports tick latency against an SLO, reads that had to
+ *          fall back to the old holder, and rebalancing progress.
+ *
+ * Compile: g++ -std=c++17 -O2 -Isrc -o ipfs_bench bench/bench_main.cpp
+ */
+
+#pragma once
+#include "BenchUtil.h"
+#include "RingFixture.h"
+
+/**
+ * @brief One scale-out run and its foreground statistics
+ */
+struct RebalanceRun {
+    vector<double> tickMs;
+    vector<long long> pendingAfterTick;     // Ranges not fully handed over
+    vector<long long> movedAfterTick;
+    long long misses = 0;           // Lookups that found no file at all
+    long long fallbacks = 0;        // Lookups served by the old holder
+    long long hotFallbacks = 0;     // ... of which in the hot slice
+    double joinMs = 0;              // Slowest tick with a join
+    int ticksToIdle = 0;
+};
+
+/**
+ * @brief Join one machine per tick from tick 10, then serve until moves finish
+ * @param filesPerSec Rebalancer budget; < 0 = synchronous Traverse_insert()
+ */
+inline RebalanceRun runScaleOut(CircularLinkedList* ring, const vector<int>& joins,
+                                const vector<uint64_t>& files, double filesPerSec, double bytesPerSec,
+                                bool hotFirst, int lookupsPerTick, int hotSlice, mt19937_64& rng) {
+    const int order = 5;
+    const int warmupTicks = 10;
+    const double tickSeconds = 0.001;
+    RebalanceRun run;
+
+    if (filesPerSec >= 0) {
+        ring->enableRebalancer(bytesPerSec, filesPerSec);
+        ring->rebalancer.hotFirst = hotFirst;
+    }
+
+    vector<uint64_t> hotKeys;
+    for (uint64_t key : files) {
+        if (static_cast<int>(key) < hotSlice) hotKeys.push_back(key);
+    }
+
+    int tick = 0;
+    int idleAt = -1;
+    int lastJoinTick = warmupTicks + static_cast<int>(joins.size()) - 1;
+    while (idleAt < 0 || tick < idleAt + 10) {
+        Stopwatch sw;
+        if (tick >= warmupTicks && tick <= lastJoinTick) {
+            ring->insertAfter(joins[static_cast<size_t>(tick - warmupTicks)], order);
+            run.joinMs = max(run.joinMs, sw.elapsedMs());
+        }
+        if (tick >= warmupTicks && ring->rebalancer.isEnabled()) {
+            ring->rebalanceStep(tickSeconds, order);
+        }
+
+        for (int i = 0; i < lookupsPerTick; i++) {
+            bool hot = !hotKeys.empty() && (rng() % 10) < 8;   // 80% of reads hit the hot slice
+            int key = static_cast<int>(hot ? hotKeys[rng() % hotKeys.size()] : files[rng() % files.size()]);
+            CircularNode* owner = ring->succ(key);
+            if (owner->BTreeroot.searchFile(key)) continue;
+            if (ring->locateFile(owner, key) == nullptr) {
+                run.misses++;
+            } else {
+                run.fallbacks++;
+                if (hot) run.hotFallbacks++;
+            }
+        }
+        run.tickMs.push_back(sw.elapsedMs());
+        run.pendingAfterTick.push_back(static_cast<long long>(ring->rebalancer.pendingCount()));
+        run.movedAfterTick.push_back(ring->rebalancer.filesMoved);
+        if (idleAt < 0 && tick >= lastJoinTick && ring->rebalancer.isIdle()) idleAt = tick;
+        tick++;
+    }
+    run.ticksToIdle = idleAt - warmupTicks + 1;
+    return run;
+}
+
+/**
+ * @brief ipfs_bench rebalance [--machines=N] [--joins=J] [--files=F]
+ *        [--rate=files/s] [--mbps=MB/s] [--lookups=L] [--slo=ms]
+ */
+inline int runRebalanceBench(int argc, char** argv) {
+    int machines = static_cast<int>(getOption(argc, argv, "machines", 16));
+    int numJoins = static_cast<int>(getOption(argc, argv, "joins", 16));
+    int numFiles = static_cast<int>(getOption(argc, argv, "files", 200000));
+    double rate = static_cast<double>(getOption(argc, argv, "rate", 200000));
+    double mbps = static_cast<double>(getOption(argc, argv, "mbps", 4000));
+    int lookups = static_cast<int>(getOption(argc, argv, "lookups", 500));
+    double slo = static_cast<double>(getOption(argc, argv, "slo", 5));
+    const int bits = 24;
+    const int order = 5;
+
+    printBenchHeader("REBALANCING: synchronous handoff vs throttled background moves");
+    cout << "  " << machines << " machines + " << numJoins << " joining, " << numFiles
+         << " files (1-65 KB), " << lookups << " lookups per 1 ms tick,\n";
+    cout << "  80% of lookups in the hot 1/16 of the key space; SLO = " << slo << " ms per tick.\n\n";
+
+    mt19937_64 rng(5);
+    vector<uint64_t> ids = uniqueRandomKeys(static_cast<size_t>(machines + numJoins), bits, rng);
+    shuffle(ids.begin(), ids.end(), rng);
+    vector<uint64_t> initial(ids.begin(), ids.begin() + machines);
+    vector<int> joins;
+    for (size_t i = static_cast<size_t>(machines); i < ids.size(); i++) joins.push_back(static_cast<int>(ids[i]));
+    vector<uint64_t> files = uniqueRandomKeys(static_cast<size_t>(numFiles), bits, rng);
+    int hotSlice = (1 << bits) / 16;
+
+    struct Mode {
+        string name;
+        double filesPerSec;
+        double bytesPerSec;
+        bool hotFirst;
+    };
+    vector<Mode> modes = {
+        { "synchronous", -1, 0, true },
+        { formatCount(static_cast<uint64_t>(rate)) + " files/s", rate, 0, true },
+        { "  FIFO order", rate, 0, false },
+        { fixedStr(mbps, 0) + " MB/s", 0, mbps * 1e6, true },
+    };
+
+    vector<int> widths = { 14, 9, 8, 8, 8, 9, 10, 10, 8 };
+    printRule(widths);
+    printRow({ "Mode", "Join ms", "Ticks", "p50 ms", "p99 ms", "Max ms", "Over SLO", "Fallback", "Misses" },
+             widths);
+    printRule(widths);
+
+    bool allOk = true;
+    RebalanceRun progressRun;
+    for (size_t m = 0; m < modes.size(); m++) {
+        const Mode& mode = modes[m];
+        CircularLinkedList* ring = buildRing(bits, initial, files, order);
+        RebalanceRun run = runScaleOut(ring, joins, files, mode.filesPerSec, mode.bytesPerSec,
+                                       mode.hotFirst, lookups, hotSlice, rng);
+        bool placed = filesPlacedCorrectly(ring, files.size());
+        allOk = allOk && placed && run.misses == 0;
+
+        long long overSlo = count_if(run.tickMs.begin(), run.tickMs.end(), [&](double t) { return t > slo; });
+        printRow({ mode.name, fixedStr(run.joinMs, 1), to_string(run.ticksToIdle),
+                   fixedStr(percentile(run.tickMs, 0.50), 2), fixedStr(percentile(run.tickMs, 0.99), 2),
+                   fixedStr(percentile(run.tickMs, 1.0), 1), to_string(overSlo),
+                   to_string(run.fallbacks) + (mode.hotFirst ? "" : "*"),
+                   placed ? to_string(run.misses) : "MISPLACED" }, widths);
+        if (m == 1) progressRun = run;
+        delete ring;
+    }
+    printRule(widths);
+    cout << "  Fallback = reads served by the previous holder before the move (*: hot slice "
+         << "not prioritized).\n\n";
+
+    // Progress of the throttled run: queued ranges and foreground latency over time
+    vector<int> progressWidths = { 10, 12, 10, 10 };
+    cout << "  Progress at " << modes[1].name << ":\n";
+    printRule(progressWidths);
+    printRow({ "Sim ms", "Ranges", "Moved %", "p99 ms" }, progressWidths);
+    printRule(progressWidths);
+    long long total = progressRun.movedAfterTick.empty() ? 0 : progressRun.movedAfterTick.back();
+    size_t ticks = progressRun.tickMs.size();
+    size_t window = max<size_t>(1, ticks / 10);
+    for (size_t start = 0; start < ticks; start += window) {
+        size_t end = min(ticks, start + window);
+        vector<double> slice(progressRun.tickMs.begin() + start, progressRun.tickMs.begin() + end);
+        long long pending = progressRun.pendingAfterTick[end - 1];
+        double movedPct = total > 0 ? 100.0 * progressRun.movedAfterTick[end - 1] / total : 100.0;
+        printRow({ to_string(end), to_string(pending), fixedStr(movedPct, 1),
+                   fixedStr(percentile(slice, 0.99), 2) }, progressWidths);
+    }
+    printRule(progressWidths);
+    return allOk ? 0 : 1;
+}
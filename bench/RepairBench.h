@@ -0,0 +1,139 @@
+/**
+ * @file RepairBench.h
+ * @brief Replica divergence with and without read repair
+ * @details N = 3 successor-list replicas under a strict quorum, so a
+ *          replica that is unreachable during a put misses it and stays
+ *          behind after it comes back. The same puts, gets and failures
+ *          replay with read repair off and on for several R/W settings.
+ *          Reports stale gets, stale replies and repair traffic per get,
+ *          Lamport-ordered puts that landed behind an earlier acknowledged
+ *          one, and the share of replica copies still behind at the end.
+ *
+ * Compile: g++ -std=c++17 -O2 -Isrc -o ipfs_bench bench/bench_main.cpp
+ */
+
+#pragma once
+#include "BenchUtil.h"
+#include "IPFS.h"
+#include "QuorumStore.h"
+#include "RingFixture.h"
+#include "Workload.h"
+
+/**
+ * @brief ipfs_bench repair [--machines=N] [--keys=K] [--ops=O] [--down=PCT]
+ */
+inline int runRepairBench(int argc, char** argv) {
+    int machines = static_cast<int>(getOption(argc, argv, "machines", 512));
+    int numKeys = static_cast<int>(getOption(argc, argv, "keys", 20000));
+    int ops = static_cast<int>(getOption(argc, argv, "ops", 100000));
+    double downShare = getOption(argc, argv, "down", 5) / 100.0;
+    const int bits = 24;
+    const int order = 5;
+    const int replication = 3;
+    const int churnEvery = 2000;    // Ops between failure changes
+
+    printBenchHeader("READ REPAIR: replica divergence under a strict quorum");
+    cout << "  " << machines << " machines, N = " << replication << " successor replicas, " << numKeys
+         << " keys (1-65 KB); " << ops << " ops (30% puts, Zipf 0.9 keys);\n";
+    cout << "  " << fixedStr(100 * downShare, 0) << "% of machines unreachable, a quarter of them replaced every "
+         << churnEvery << " ops.\n\n";
+
+    mt19937_64 rng(131);
+    vector<uint64_t> ids = uniqueRandomKeys(static_cast<size_t>(machines), bits, rng);
+    vector<int> idList(ids.begin(), ids.end());
+    vector<uint64_t> keys = uniqueRandomKeys(static_cast<size_t>(numKeys), bits, rng);
+
+    vector<int> widths = { 5, 7, 9, 11, 11, 11, 11, 11 };
+    printRule(widths);
+    printRow({ "R/W", "Repair", "Stale %", "Stale rep.", "Repairs", "Repair KB", "Reordered", "Behind %" }, widths);
+    printRule(widths);
+
+    vector<pair<int, int>> settings = { { 1, 1 }, { 1, 2 }, { 2, 2 } };
+    for (const pair<int, int>& rw : settings) {
+        for (bool repair : { false, true }) {
+            IPFS ipfs(bits, order);
+            ipfs.SetVerbose(false);
+            ipfs.EnableReplication(ReplicaMode::SuccessorList, replication);
+            ipfs.ApplyMembershipBatch(idList, {});
+            CircularLinkedList* ring = ipfs.C;
+            LatencyModel model(137);
+            QuorumStore store(ring, model, rw.first, rw.second, false);
+            store.readRepair = repair;
+
+            // Load every key with all machines up
+            unordered_map<int, long long> acked;    // Key -> newest acknowledged version
+            for (uint64_t key : keys) {
+                int k = static_cast<int>(key);
+                acked[k] = store.put(idList[0], k, "file_" + to_string(k), fileSizeFor(key)).version;
+            }
+
+            // Same failures and operations for every setting
+            mt19937_64 opRng(139);
+            Workload workload(keys, bits, 0.0, 0.0, 0.9, 149);
+            vector<int> failed;
+            size_t target = static_cast<size_t>(downShare * machines);
+            long long gets = 0, getOk = 0, stale = 0, putOk = 0, reordered = 0;
+            for (int op = 0; op < ops; op++) {
+                if (op % churnEvery == 0) {
+                    size_t replaced = failed.size() / 4;
+                    for (size_t i = 0; i < replaced; i++) {
+                        size_t j = static_cast<size_t>(opRng() % failed.size());
+                        store.recover(failed[j]);
+                        failed[j] = failed.back();
+                        failed.pop_back();
+                    }
+                    while (failed.size() < target) {
+                        int id = idList[opRng() % idList.size()];
+                        if (!store.isUp(id)) continue;
+                        store.fail(id);
+                        failed.push_back(id);
+                    }
+                }
+                int origin = idList[opRng() % idList.size()];
+                int key = workload.next().key;
+                if (opRng() % 10 < 3) {
+                    QuorumResult r = store.put(origin, key, "file_" + to_string(key) + "_v" + to_string(op),
+                                               fileSizeFor(static_cast<uint64_t>(key) + static_cast<uint64_t>(op)));
+                    if (!r.ok) continue;
+                    putOk++;
+                    if (r.version < acked[key]) reordered++;
+                    acked[key] = max(acked[key], r.version);
+                } else {
+                    gets++;
+                    QuorumResult r = store.get(origin, key);
+                    if (!r.ok) continue;
+                    getOk++;
+                    if (r.version < acked[key]) stale++;
+                }
+            }
+
+            // Bring everyone back and count replica copies behind the newest one
+            for (int id : failed) store.recover(id);
+            store.applyRepairs();
+            long long behind = 0;
+            for (uint64_t key : keys) {
+                int k = static_cast<int>(key);
+                vector<CircularNode*> holders = { ring->ownerOf(k) };
+                for (CircularNode* m : ring->replicaSet(k)) holders.push_back(m);
+                for (CircularNode* m : holders) {
+                    FileNode* copy = m->BTreeroot.findFile(k);
+                    if (copy == nullptr) copy = m->replicaStore.findFile(k);
+                    if (copy == nullptr || copy->version < acked[k]) behind++;
+                }
+            }
+
+            double g = static_cast<double>(gets);
+            printRow({ repair ? "" : to_string(rw.first) + "/" + to_string(rw.second), repair ? "On" : "Off",
+                       fixedStr(getOk > 0 ? 100.0 * stale / getOk : 0, 2), fixedStr(store.staleReplies / g, 3),
+                       fixedStr(store.repairs / g, 3), fixedStr(store.repairBytes / 1024.0 / g, 2),
+                       fixedStr(putOk > 0 ? 100.0 * reordered / putOk : 0, 3) + "%",
+                       fixedStr(100.0 * behind / (static_cast<double>(keys.size()) * replication), 2) }, widths);
+        }
+        printRule(widths);
+    }
+    cout << "  Per get: Stale rep. = replies older than the freshest of the N, Repairs / Repair KB =\n";
+    cout << "  repair messages and bytes sent. Reordered = acknowledged puts whose Lamport version is\n";
+    cout << "  below an earlier acknowledged put of the same key. Behind % = replica copies older than\n";
+    cout << "  the newest acknowledged put after every machine is back.\n";
+    return 0;
+}
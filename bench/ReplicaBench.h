@@ -0,0 +1,194 @@
+/**
+ * @file ReplicaBench.h
+ * @brief Replica placement: successor list vs rendezvous (HRW) vs HRW skeleton
+ * @details Stores every file on 3 machines and reports selection cost, the
+ *          share of replica copies that move per join and per leave, how a
+ *          failed machine's load spreads over the survivors and the replica
+ *          balance. A second table shows HRW selection cost against ring size:
+ *          O(N) flat scoring vs O(log N) skeleton descent, and a third how a
+ *          skeleton configured for 64 machines deepens as batches join.
+ *
+ * Compile: g++ -std=c++17 -O2 -Isrc -o ipfs_bench bench/bench_main.cpp
+ */
+
+#pragma once
+#include <unordered_map>
+#include <unordered_set>
+#include "BenchUtil.h"
+#include "IPFS.h"
+
+/**
+ * @brief All (file key, machine) replica pairs currently stored
+ */
+inline unordered_set<uint64_t> snapshotReplicas(CircularLinkedList* ring) {
+    unordered_set<uint64_t> pairs;
+    CircularNode* current = ring->head;
+    do {
+        if (current->replicaStore.root != nullptr) {
+            for (const FileNode& file : current->replicaStore.getAllFiles(current->replicaStore.root)) {
+                pairs.insert((static_cast<uint64_t>(file.key) << 32) | static_cast<uint32_t>(current->key));
+            }
+        }
+        current = current->next;
+    } while (current != ring->head);
+    return pairs;
+}
+
+/**
+ * @brief ipfs_bench replica [--machines=N] [--files=F] [--factor=R] [--churn=C]
+ */
+inline int runReplicaBench(int argc, char** argv) {
+    int machines = static_cast<int>(getOption(argc, argv, "machines", 64));
+    int numFiles = static_cast<int>(getOption(argc, argv, "files", 50000));
+    int factor = static_cast<int>(getOption(argc, argv, "factor", 3));
+    int churn = static_cast<int>(getOption(argc, argv, "churn", 8));
+    const int bits = 24;
+    const int order = 5;
+
+    printBenchHeader("REPLICA PLACEMENT: successor list vs rendezvous hashing");
+    cout << "  " << machines << " machines, " << numFiles << " files x " << factor << " copies; "
+         << churn << " joins and " << churn << " leaves.\n";
+    cout << "  Minimum replica move per change = 1/N = " << fixedStr(100.0 / machines, 2) << "%.\n\n";
+
+    mt19937_64 rng(37);
+    vector<uint64_t> ids = uniqueRandomKeys(static_cast<size_t>(machines + churn), bits, rng);
+    shuffle(ids.begin(), ids.end(), rng);
+    vector<int> initial(ids.begin(), ids.begin() + machines);
+    vector<int> joins(ids.begin() + machines, ids.end());
+    vector<int> leaves(initial.begin(), initial.begin() + churn);
+    vector<uint64_t> files = uniqueRandomKeys(static_cast<size_t>(numFiles), bits, rng);
+
+    const ReplicaMode modes[] = { ReplicaMode::SuccessorList, ReplicaMode::Rendezvous, ReplicaMode::Skeleton };
+    vector<int> widths = { 15, 10, 9, 9, 11, 10, 9 };
+    printRule(widths);
+    printRow({ "Replicas", "ns/select", "Join %", "Leave %", "Failover %", "Max/mean", "Check" }, widths);
+    printRule(widths);
+
+    bool allOk = true;
+    for (ReplicaMode mode : modes) {
+        IPFS ipfs(bits, order);
+        ipfs.SetVerbose(false);
+        ipfs.EnableReplication(mode, factor);
+        ipfs.ApplyMembershipBatch(initial, {});
+        for (uint64_t key : files) {
+            ipfs.Put(static_cast<int>(key), "file_" + to_string(key), fileSizeFor(key));
+        }
+        CircularLinkedList* ring = ipfs.C;
+
+        Stopwatch sw;
+        for (uint64_t key : files) benchSink = benchSink + ring->replicaSet(static_cast<int>(key)).size();
+        double selectNs = sw.elapsedNs() / static_cast<double>(files.size());
+
+        // Failover: where the first replicas of one machine's primaries live
+        CircularNode* victim = ring->findMachineById(initial[0]);
+        unordered_map<int, long long> takeover;
+        long long victimFiles = 0;
+        for (const FileNode& file : victim->BTreeroot.getAllFiles(victim->BTreeroot.root)) {
+            vector<CircularNode*> set = ring->replicaSet(file.key);
+            if (!set.empty()) takeover[set[0]->key]++;
+            victimFiles++;
+        }
+        long long peakTakeover = 0;
+        for (const auto& entry : takeover) peakTakeover = max(peakTakeover, entry.second);
+
+        // Replica copies that appear on a new machine per membership change
+        double joinMoved = 0, leaveMoved = 0;
+        unordered_set<uint64_t> before = snapshotReplicas(ring);
+        for (int i = 0; i < 2 * churn; i++) {
+            if (i < churn) {
+                ipfs.InsertMachine(joins[static_cast<size_t>(i)], order);
+            } else {
+                ipfs.DeleteMachine(leaves[static_cast<size_t>(i - churn)], order);
+            }
+            unordered_set<uint64_t> after = snapshotReplicas(ring);
+            size_t added = 0;
+            for (uint64_t pair : after) {
+                if (before.count(pair) == 0) added++;
+            }
+            (i < churn ? joinMoved : leaveMoved) += after.empty() ? 0.0 : static_cast<double>(added) / after.size();
+            before.swap(after);
+        }
+
+        // Balance of replica copies and consistency with the replica sets
+        bool ok = before.size() == files.size() * static_cast<size_t>(factor - 1);
+        double peak = 0;
+        CircularNode* current = ring->head;
+        do {
+            peak = max(peak, static_cast<double>(current->replicaStore.countFiles(current->replicaStore.root)));
+            current = current->next;
+        } while (current != ring->head);
+        for (size_t i = 0; i < files.size() && ok; i += 97) {
+            for (CircularNode* machine : ring->replicaSet(static_cast<int>(files[i]))) {
+                if (!machine->replicaStore.searchFile(static_cast<int>(files[i]))) ok = false;
+            }
+        }
+        allOk = allOk && ok;
+        double mean = static_cast<double>(before.size()) / ipfs.getMachineCount();
+
+        printRow({ ring->replicas.name(), fixedStr(selectNs, 0), fixedStr(100.0 * joinMoved / churn, 2),
+                   fixedStr(100.0 * leaveMoved / churn, 2),
+                   fixedStr(victimFiles > 0 ? 100.0 * peakTakeover / victimFiles : 0, 1),
+                   fixedStr(mean > 0 ? peak / mean : 0, 2), ok ? "OK" : "MISMATCH" }, widths);
+    }
+    printRule(widths);
+    cout << "  Failover % = share of a failed machine's files whose first replica is on the same machine.\n\n";
+
+    // Selection cost against ring size
+    vector<int> scaleWidths = { 10, 16, 16 };
+    cout << "  HRW selection of " << (factor - 1) << " replicas vs ring size:\n";
+    printRule(scaleWidths);
+    printRow({ "Machines", "Rendezvous ns", "Skeleton ns" }, scaleWidths);
+    printRule(scaleWidths);
+    for (int n : { 64, 1024, 16384, 131072 }) {
+        vector<uint64_t> scaleIds = uniqueRandomKeys(static_cast<size_t>(n), bits, rng);
+        vector<int> idList(scaleIds.begin(), scaleIds.end());
+        vector<string> row = { to_string(n) };
+        for (ReplicaMode mode : { ReplicaMode::Rendezvous, ReplicaMode::Skeleton }) {
+            ReplicaSelector selector;
+            selector.configure(mode, factor, idList);
+            int lookups = max(1000, 2000000 / n);
+            Stopwatch scaleSw;
+            for (int i = 0; i < lookups; i++) {
+                benchSink = benchSink + selector.select(static_cast<int>(rng()), static_cast<size_t>(factor - 1), -1).size();
+            }
+            row.push_back(fixedStr(scaleSw.elapsedNs() / lookups, 0));
+        }
+        printRow(row, scaleWidths);
+    }
+    printRule(scaleWidths);
+
+    // Skeleton configured for 64 machines, then grown by batched joins
+    cout << "\n  HRW skeleton grown from 64 machines by join batches (deepened past "
+         << ReplicaSelector::MAX_LEAF_LOAD << " per leaf):\n";
+    vector<int> growWidths = { 10, 7, 11, 11, 12, 12 };
+    printRule(growWidths);
+    printRow({ "Machines", "Depth", "Leaf load", "Update ms", "Grown ns", "Fresh ns" }, growWidths);
+    printRule(growWidths);
+    vector<uint64_t> growIds = uniqueRandomKeys(131072, bits, rng);
+    vector<int> growList(growIds.begin(), growIds.end());
+    ReplicaSelector grown;
+    grown.configure(ReplicaMode::Skeleton, factor, vector<int>(growList.begin(), growList.begin() + 64));
+    for (size_t n = 64; n <= growList.size(); n *= 4) {
+        double updateMs = 0;
+        if (n > 64) {
+            vector<int> batch(growList.begin() + static_cast<long>(n / 4), growList.begin() + static_cast<long>(n));
+            Stopwatch updateSw;
+            grown.update(batch, {});
+            updateMs = updateSw.elapsedMs();
+        }
+        ReplicaSelector fresh;
+        fresh.configure(ReplicaMode::Skeleton, factor, vector<int>(growList.begin(), growList.begin() + static_cast<long>(n)));
+        vector<string> row = { to_string(n), to_string(grown.depth()), fixedStr(grown.leafLoad(), 0), fixedStr(updateMs, 1) };
+        for (const ReplicaSelector* selector : { &grown, &fresh }) {
+            int lookups = 20000;
+            Stopwatch growSw;
+            for (int i = 0; i < lookups; i++) {
+                benchSink = benchSink + selector->select(static_cast<int>(rng()), static_cast<size_t>(factor - 1), -1).size();
+            }
+            row.push_back(fixedStr(growSw.elapsedNs() / lookups, 0));
+        }
+        printRow(row, growWidths);
+    }
+    printRule(growWidths);
+    return allOk ? 0 : 1;
+}
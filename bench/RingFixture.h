@@ -0,0 +1,53 @@
+/**
+ * @file RingFixture.h
+ * @brief Shared ring setup and placement checks for the benchmarks
+ *
+ * Compile: g++ -std=c++17 -O2 -Isrc -o ipfs_bench bench/bench_main.cpp
+ */
+
+#pragma once
+#include "BenchUtil.h"
+#include "CircularLL.h"
+
+/**
+ * @brief Deterministic file size, 1 KB plus up to 64 KB
+ */
+inline long long fileSizeFor(uint64_t key) {
+    return 1024 + static_cast<long long>((key * 0x9E3779B97F4A7C15ULL) >> 48);
+}
+
+/**
+ * @brief Ring with the given machines and files, progress output silenced
+ */
+inline CircularLinkedList* buildRing(int bits, const vector<uint64_t>& machines,
+                                     const vector<uint64_t>& files, int order) {
+    CircularLinkedList* ring = new CircularLinkedList(1 << bits, order);
+    ring->verbose = false;
+    for (uint64_t id : machines) ring->insert(static_cast<int>(id));
+    ring->updateRT();
+    for (uint64_t key : files) {
+        CircularNode* owner = ring->succ(static_cast<int>(key));
+        owner->BTreeroot.insertHelper(FileNode(static_cast<int>(key), "file_" + to_string(key),
+                                               fileSizeFor(key)), order);
+    }
+    return ring;
+}
+
+/**
+ * @brief Every file stored on succ(key) and none lost
+ */
+inline bool filesPlacedCorrectly(CircularLinkedList* ring, size_t expectedFiles) {
+    size_t total = 0;
+    CircularNode* current = ring->head;
+    if (current == nullptr) return expectedFiles == 0;
+    do {
+        if (current->BTreeroot.root != nullptr) {
+            for (const FileNode& file : current->BTreeroot.getAllFiles(current->BTreeroot.root)) {
+                if (ring->succ(file.key) != current) return false;
+                total++;
+            }
+        }
+        current = current->next;
+    } while (current != ring->head);
+    return total == expectedFiles;
+}
@@ -0,0 +1,145 @@
+/**
+ * @file RoutingBench.h
+ * @brief Routing engines: Chord fingers vs Pastry prefix routing vs Koorde
+ * @details Builds rings of increasing size and routes random keys from
+ *          random machines with each engine. Reports average and worst hop
+ *          count, hops to keys just behind the origin (the worst case for
+ *          clockwise-only fingers), routing state per machine (entries and bytes), routing
+ *          state of the whole ring, time per routeToKey() call and the time
+ *          to rebuild all routing state.
+ *
+ * Compile: g++ -std=c++17 -O2 -Isrc -o ipfs_bench bench/bench_main.cpp
+ */
+
+#pragma once
+#include "BenchUtil.h"
+#include "IPFS.h"
+
+/**
+ * @brief One routing engine configuration in the comparison
+ */
+struct RoutingEngine {
+    string name;
+    RoutingMode mode;
+    int param;          // Pastry digit bits / Koorde shift bits
+    bool bidirectional; // Chord: counter-clockwise fingers too
+};
+
+/**
+ * @brief Route lookups random keys from random machines
+ * @param behindSpan If > 0, keys are drawn from the behindSpan IDs just before the origin
+ * @return Average hops; worst case in maxHops, ns per lookup in nsPerLookup
+ */
+inline double measureRouting(CircularLinkedList* ring, const vector<int>& ids, int lookups,
+                             mt19937_64& rng, int& maxHops, double& nsPerLookup, int behindSpan = 0) {
+    vector<pair<int, int>> queries;
+    long long space = ring->identifierSpace;
+    for (int i = 0; i < lookups; i++) {
+        int origin = ids[rng() % ids.size()];
+        long long key = behindSpan > 0 ? (origin - 1 - static_cast<long long>(rng() % static_cast<uint64_t>(behindSpan)) + space) % space
+                                       : static_cast<long long>(rng() % static_cast<uint64_t>(space));
+        queries.push_back({ origin, static_cast<int>(key) });
+    }
+    long long totalHops = 0;
+    maxHops = 0;
+    Stopwatch sw;
+    for (const auto& q : queries) {
+        int hops = static_cast<int>(ring->routeToKey(q.first, q.second).size()) - 1;
+        totalHops += hops;
+        maxHops = max(maxHops, hops);
+    }
+    nsPerLookup = sw.elapsedNs() / lookups;
+    return static_cast<double>(totalHops) / lookups;
+}
+
+/**
+ * @brief Routing entries and bytes per machine for the active engine,
+ *        averaged over the ring
+ */
+inline void routingState(CircularLinkedList* ring, double& entries, double& bytes) {
+    size_t n = static_cast<size_t>(ring->getMachineCount());
+    if (ring->routing == RoutingMode::Pastry) {
+        long long total = 0;
+        for (size_t i = 0; i < n; i++) total += ring->pastry.stateEntries(i);
+        entries = static_cast<double>(total) / n;
+        bytes = static_cast<double>(ring->pastry.table.size() * sizeof(int)) / n
+              + ring->pastry.leafSetSize * sizeof(int);
+    } else if (ring->routing == RoutingMode::Koorde) {
+        entries = ring->koorde.stateEntries();
+        bytes = entries * sizeof(int);
+    } else {
+        long long total = 0;
+        CircularNode* current = ring->head;
+        do {
+            total += current->RT.size() + current->CCW.size();
+            current = current->next;
+        } while (current != ring->head);
+        entries = static_cast<double>(total) / n;
+        bytes = entries * sizeof(DoublyNode<CircularNode>);
+    }
+}
+
+/**
+ * @brief ipfs_bench routing [--max=N] [--lookups=L]
+ */
+inline int runRoutingBench(int argc, char** argv) {
+    int maxMachines = static_cast<int>(getOption(argc, argv, "max", 65536));
+    int lookups = static_cast<int>(getOption(argc, argv, "lookups", 20000));
+    const int bits = 24;
+    const int order = 5;
+
+    printBenchHeader("ROUTING ENGINES: Chord fingers vs Pastry prefix routing vs Koorde");
+    cout << "  " << bits << "-bit IDs, " << lookups << " lookups of random keys from random machines.\n";
+    cout << "  Pastry leaf set L = " << PastryRouter::DEFAULT_LEAF_SET << ".\n\n";
+
+    vector<RoutingEngine> engines = {
+        { "Chord", RoutingMode::Chord, 0, false },
+        { "Chord bidir", RoutingMode::Chord, 0, true },
+        { "Pastry b=2", RoutingMode::Pastry, 2, false },
+        { "Pastry b=4", RoutingMode::Pastry, 4, false },
+        { "Koorde k=2", RoutingMode::Koorde, 1, false },
+        { "Koorde k=8", RoutingMode::Koorde, 3, false },
+    };
+
+    vector<int> widths = { 9, 12, 9, 9, 9, 10, 11, 10, 10, 10 };
+    printRule(widths);
+    printRow({ "Machines", "Engine", "Avg hops", "Max hops", "Behind", "Entries", "Bytes/node", "Ring KB",
+               "ns/lookup", "Build ms" }, widths);
+    printRule(widths);
+
+    mt19937_64 rng(41);
+    for (int n = 256; n <= maxMachines; n *= 16) {
+        vector<uint64_t> keys = uniqueRandomKeys(static_cast<size_t>(n), bits, rng);
+        vector<int> ids(keys.begin(), keys.end());
+        IPFS ipfs(bits, order);
+        ipfs.SetVerbose(false);
+        ipfs.ApplyMembershipBatch(ids, {});
+        CircularLinkedList* ring = ipfs.C;
+
+        for (const RoutingEngine& engine : engines) {
+            Stopwatch build;
+            ring->bidirectional = engine.bidirectional;
+            ring->setRouting(engine.mode, engine.param);
+            double buildMs = build.elapsedMs();
+
+            int maxHops;
+            double ns;
+            double hops = measureRouting(ring, ids, lookups, rng, maxHops, ns);
+            int behindMax;
+            double behindNs;
+            double behind = measureRouting(ring, ids, lookups, rng, behindMax, behindNs, ring->identifierSpace / 64);
+            double entries, bytes;
+            routingState(ring, entries, bytes);
+            printRow({ &engine == &engines[0] ? to_string(n) : "", engine.name, fixedStr(hops, 2),
+                       to_string(maxHops), fixedStr(behind, 2), fixedStr(entries, 1), fixedStr(bytes, 0),
+                       fixedStr(bytes * n / 1024.0, 0), fixedStr(ns, 0),
+                       fixedStr(buildMs, 1) }, widths);
+        }
+        printRule(widths);
+    }
+    cout << "  Chord entries = fingers stored per machine; Pastry = non-empty table entries + leaf set;\n";
+    cout << "  Koorde = successor + k de Bruijn pointers.\n";
+    cout << "  Behind = average hops to keys in the 1/64 of the ring just before the origin.\n";
+    cout << "  Pastry bytes include the empty slots of its dense table.\n";
+    return 0;
+}
@@ -0,0 +1,108 @@
+/**
+ * @file ShortcutBench.h
+ * @brief Learned shortcut links: hops under uniform vs skewed lookups
+ * @details A set of client machines each look up keys from their own Zipf
+ *          popularity ranking over a shared key pool, so every client keeps
+ *          hitting the same few owners. After a warm-up the bench reports
+ *          Chord hops, the share of lookups finished in one hop and time per
+ *          lookup for several shortcut budgets, plus a uniform run where
+ *          shortcuts have nothing to learn and a shifting run where every
+ *          client draws a new key ranking four times per phase, so the cache
+ *          must keep admitting new owners.
+ *
+ * Compile: g++ -std=c++17 -O2 -Isrc -o ipfs_bench bench/bench_main.cpp
+ */
+
+#pragma once
+#include "BenchUtil.h"
+#include "IPFS.h"
+#include "Workload.h"
+
+/**
+ * @brief ipfs_bench shortcuts [--machines=N] [--clients=C] [--keys=K] [--lookups=L]
+ */
+inline int runShortcutBench(int argc, char** argv) {
+    int machines = static_cast<int>(getOption(argc, argv, "machines", 4096));
+    int clients = static_cast<int>(getOption(argc, argv, "clients", 64));
+    int numKeys = static_cast<int>(getOption(argc, argv, "keys", 20000));
+    int lookups = static_cast<int>(getOption(argc, argv, "lookups", 40000));
+    const int bits = 24;
+    const int order = 5;
+
+    printBenchHeader("SHORTCUT LINKS: learned from lookup traffic");
+    cout << "  " << machines << " machines, " << clients << " clients, " << numKeys << " keys; "
+         << lookups << " warm-up + " << lookups << " measured Chord lookups.\n\n";
+
+    mt19937_64 rng(47);
+    vector<uint64_t> ids = uniqueRandomKeys(static_cast<size_t>(machines), bits, rng);
+    vector<int> idList(ids.begin(), ids.end());
+    vector<uint64_t> keys = uniqueRandomKeys(static_cast<size_t>(numKeys), bits, rng);
+    vector<int> origins(idList.begin(), idList.begin() + min(clients, machines));
+
+    vector<int> widths = { 10, 7, 9, 9, 10, 10, 10 };
+    printRule(widths);
+    printRow({ "Workload", "Slots", "Avg hops", "Max hops", "Saved %", "1-hop %", "ns/lookup" }, widths);
+    printRule(widths);
+
+    int shiftEvery = max(1, lookups / 4);
+    for (int scenario = 0; scenario < 3; scenario++) {
+        double theta = scenario == 0 ? 0.0 : 0.99;
+        bool shifting = scenario == 2;
+        double baseline = 0;
+        for (int slots : { 0, 4, 8, 16 }) {
+            IPFS ipfs(bits, order);
+            ipfs.SetVerbose(false);
+            ipfs.ApplyMembershipBatch(idList, {});
+            ipfs.SetShortcuts(slots);
+            CircularLinkedList* ring = ipfs.C;
+
+            // Each client ranks the keys differently; same seeds for every budget
+            vector<Workload> workloads;
+            auto rank = [&](uint64_t round) {
+                workloads.clear();
+                for (size_t c = 0; c < origins.size(); c++) {
+                    workloads.emplace_back(keys, bits, 0.0, 0.0, theta, 1000 + c + round * origins.size());
+                }
+            };
+            rank(0);
+            mt19937_64 pick(53);
+            int issued = 0;
+            auto query = [&]() {
+                if (shifting && ++issued % shiftEvery == 0) rank(static_cast<uint64_t>(issued / shiftEvery));
+                size_t c = static_cast<size_t>(pick() % origins.size());
+                return make_pair(origins[c], workloads[c].next().key);
+            };
+            for (int i = 0; i < lookups; i++) {
+                pair<int, int> q = query();
+                ring->routeToKey(q.first, q.second);
+            }
+
+            vector<pair<int, int>> measured;
+            for (int i = 0; i < lookups; i++) measured.push_back(query());
+            long long totalHops = 0, oneHop = 0;
+            int maxHops = 0;
+            Stopwatch sw;
+            for (const auto& q : measured) {
+                int hops = static_cast<int>(ring->routeToKey(q.first, q.second).size()) - 1;
+                totalHops += hops;
+                maxHops = max(maxHops, hops);
+                if (hops <= 1) oneHop++;
+            }
+            double ns = sw.elapsedNs() / lookups;
+            double hops = static_cast<double>(totalHops) / lookups;
+            if (slots == 0) baseline = hops;
+
+            string label = shifting ? "Zipf shift" : (theta > 0 ? "Zipf " + fixedStr(theta, 2) : "Uniform");
+            printRow({ slots == 0 ? label : "", to_string(slots),
+                       fixedStr(hops, 2), to_string(maxHops),
+                       fixedStr(baseline > 0 ? 100.0 * (baseline - hops) / baseline : 0, 1),
+                       fixedStr(100.0 * oneHop / lookups, 1), fixedStr(ns, 0) }, widths);
+        }
+        printRule(widths);
+    }
+    cout << "  Saved % = hop reduction against no shortcuts; 1-hop % = lookups finished in at most one hop.\n";
+    cout << "  Zipf shift = all clients draw new key rankings every " << shiftEvery << " lookups.\n";
+    cout << "  Memory per machine = slots x (" << sizeof(ShortcutCache::Entry) << " + "
+         << ShortcutCache::SKETCH_PER_SLOT << " sketch) bytes.\n";
+    return 0;
+}
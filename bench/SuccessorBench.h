@@ -0,0 +1,118 @@
+/**
+ * @file SuccessorBench.h
+ * @brief Successor-structure benchmark: sorted array vs vEB trie vs bitmap
+ * @details Measures build time, succ/pred latency and memory of the
+ *          structures that can back CircularLinkedList::succ() for
+ *          1k - 10M machines in 32- and 64-bit identifier spaces.
+ * 
+ * Compile: g++ -std=c++17 -O2 -Isrc -o ipfs_bench bench/bench_main.cpp
+ */
+
+#pragma once
+#include "BenchUtil.h"
+#include "OccupancyBitmap.h"
+#include "SuccessorTrie.h"
+
+/**
+ * @brief Run queries against one structure, return ns per query
+ */
+template<typename Query>
+double timeQueries(const vector<uint64_t>& queries, Query query) {
+    Stopwatch sw;
+    uint64_t acc = 0;
+    for (uint64_t q : queries) {
+        acc += query(q);
+    }
+    benchSink = benchSink + acc;
+    return sw.elapsedNs() / static_cast<double>(queries.size());
+}
+
+/**
+ * @brief ipfs_bench succ [--max=N] [--queries=Q] [--bitmap]
+ */
+inline int runSuccessorBench(int argc, char** argv) {
+    long long maxMachines = getOption(argc, argv, "max", 1000000);
+    size_t numQueries = static_cast<size_t>(getOption(argc, argv, "queries", 1000000));
+    bool withBitmap = hasFlag(argc, argv, "bitmap");   // 512 MB for a 32-bit space
+
+    printBenchHeader("SUCCESSOR STRUCTURES: sorted array vs vEB trie vs bitmap");
+    cout << "  Random machine IDs, " << numQueries << " random succ and pred queries each.\n";
+    cout << "  Pass --max=10000000 for 10M machines, --bitmap for the 2^32 bitmap.\n\n";
+
+    vector<int> widths = { 5, 9, 18, 9, 8, 8, 10 };
+    printRule(widths);
+    printRow({ "Bits", "Machines", "Structure", "Build ms", "succ ns", "pred ns", "Memory" }, widths);
+    printRule(widths);
+
+    mt19937_64 rng(42);
+    for (int bits : { 32, 64 }) {
+        uint64_t mask = bits >= 64 ? ~0ULL : ((1ULL << bits) - 1);
+        for (long long n = 1000; n <= maxMachines; n *= 10) {
+            vector<uint64_t> keys = uniqueRandomKeys(static_cast<size_t>(n), bits, rng);
+            vector<uint64_t> queries(numQueries);
+            for (uint64_t& q : queries) q = rng() & mask;
+            string label = formatCount(static_cast<uint64_t>(n));
+
+            // Binary search over a sorted array (keys are already sorted)
+            {
+                Stopwatch sw;
+                vector<uint64_t> sorted(keys);
+                double buildMs = sw.elapsedMs();
+                double succNs = timeQueries(queries, [&](uint64_t x) {
+                    auto it = lower_bound(sorted.begin(), sorted.end(), x);
+                    return it == sorted.end() ? sorted.front() : *it;
+                });
+                double predNs = timeQueries(queries, [&](uint64_t x) {
+                    auto it = lower_bound(sorted.begin(), sorted.end(), x);
+                    return it == sorted.begin() ? sorted.back() : *(it - 1);
+                });
+                printRow({ to_string(bits), label, "sorted+bsearch", fixedStr(buildMs, 1),
+                           fixedStr(succNs, 1), fixedStr(predNs, 1),
+                           formatBytes(sorted.capacity() * sizeof(uint64_t)) }, widths);
+            }
+
+            // Layered-bitmap vEB trie
+            {
+                Stopwatch sw;
+                SuccessorTrie trie(bits);
+                for (uint64_t k : keys) trie.insert(k);
+                double buildMs = sw.elapsedMs();
+                uint64_t first = trie.minimum(), last = trie.maximum();
+                double succNs = timeQueries(queries, [&](uint64_t x) {
+                    uint64_t s = trie.successor(x);
+                    return s == SuccessorTrie::NONE ? first : s;
+                });
+                double predNs = timeQueries(queries, [&](uint64_t x) {
+                    uint64_t p = trie.predecessor(x);
+                    return p == SuccessorTrie::NONE ? last : p;
+                });
+                printRow({ to_string(bits), label, "vEB trie", fixedStr(buildMs, 1),
+                           fixedStr(succNs, 1), fixedStr(predNs, 1),
+                           formatBytes(static_cast<double>(trie.memoryBytes())) }, widths);
+            }
+
+            // Rank/select bitmap (only feasible for the 32-bit space)
+            if (withBitmap && bits == 32) {
+                Stopwatch sw;
+                OccupancyBitmap bitmap;
+                bitmap.init(1ULL << 32);
+                for (uint64_t k : keys) bitmap.set(k);
+                bitmap.rank(0);   // Build rank directory
+                double buildMs = sw.elapsedMs();
+                double succNs = timeQueries(queries, [&](uint64_t x) {
+                    int64_t s = bitmap.successor(x);
+                    return static_cast<uint64_t>(s < 0 ? bitmap.successor(0) : s);
+                });
+                double predNs = timeQueries(queries, [&](uint64_t x) {
+                    int64_t p = bitmap.predecessor(x);
+                    return static_cast<uint64_t>(p < 0 ? bitmap.predecessor(bitmap.universe) : p);
+                });
+                printRow({ to_string(bits), label, "rank/select bitmap", fixedStr(buildMs, 1),
+                           fixedStr(succNs, 1), fixedStr(predNs, 1),
+                           formatBytes(static_cast<double>(bitmap.memoryBytes())) }, widths);
+            }
+        }
+        printRule(widths);
+    }
+    return 0;
+}
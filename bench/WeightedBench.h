@@ -0,0 +1,111 @@
+/**
+ * @file WeightedBench.h
+ * @brief Weighted capacity benchmark: file and request share vs host weight
+ * @details Hosts of weight 1, 2, 4 and 8 join through HostRegistry with a
+ *          varying number of virtual positions per weight unit. For each
+ *          setting the spread of (load share / weight share) across hosts
+ *          shows how closely storage and request rate follow capacity.
+ *
+ * Compile: g++ -std=c++17 -O2 -Isrc -o ipfs_bench bench/bench_main.cpp
+ */
+
+#pragma once
+#include "BenchUtil.h"
+#include "RingFixture.h"
+#include "HostRegistry.h"
+
+/**
+ * @brief Ring of weighted hosts holding files, with uniform random lookups
+ */
+inline CircularLinkedList* buildWeightedRing(HostRegistry& registry, const vector<int>& weights,
+                                             const vector<uint64_t>& files, size_t lookups,
+                                             int bits, mt19937_64& rng) {
+    const int order = 5;
+    CircularLinkedList* ring = new CircularLinkedList(1 << bits, order);
+    ring->verbose = false;
+    for (size_t i = 0; i < weights.size(); i++) {
+        registry.addHost(*ring, "host" + to_string(i), weights[i], order);
+    }
+    for (uint64_t key : files) {
+        ring->succ(static_cast<int>(key))->BTreeroot.insertHelper(
+            FileNode(static_cast<int>(key), "file_" + to_string(key), fileSizeFor(key)), order);
+    }
+    for (size_t i = 0; i < lookups; i++) {
+        int key = static_cast<int>(files[rng() % files.size()]);
+        FileNode* file = ring->succ(key)->BTreeroot.findFile(key);
+        if (file != nullptr) file->hits++;
+    }
+    return ring;
+}
+
+/**
+ * @brief ipfs_bench weighted [--files=F] [--lookups=L] [--report]
+ */
+inline int runWeightedBench(int argc, char** argv) {
+    int numFiles = static_cast<int>(getOption(argc, argv, "files", 200000));
+    size_t lookups = static_cast<size_t>(getOption(argc, argv, "lookups", 1000000));
+    const int bits = 24;
+    const vector<int> weights = { 1, 1, 1, 1, 2, 2, 2, 2, 4, 4, 8, 8 };
+
+    printBenchHeader("WEIGHTED HOSTS: load share / weight share per host");
+    cout << "  " << weights.size() << " hosts (weights 1, 2, 4, 8), " << numFiles << " files, "
+         << lookups << " uniform lookups.\n";
+    cout << "  1.00 = host carries exactly its weighted share.\n\n";
+
+    mt19937_64 rng(23);
+    vector<uint64_t> files = uniqueRandomKeys(static_cast<size_t>(numFiles), bits, rng);
+
+    vector<int> widths = { 10, 10, 11, 11, 11, 11 };
+    printRule(widths);
+    printRow({ "Pos/weight", "Positions", "Files min", "Files max", "Req min", "Req max" }, widths);
+    printRule(widths);
+
+    bool ok = true;
+    bool report = hasFlag(argc, argv, "report");
+    CircularLinkedList* reportRing = nullptr;
+    HostRegistry reportRegistry;
+    for (int vnodes : { 1, 4, 16, 64 }) {
+        HostRegistry registry;
+        registry.vnodesPerWeight = vnodes;
+        CircularLinkedList* ring = buildWeightedRing(registry, weights, files, lookups, bits, rng);
+        vector<HostRegistry::HostLoad> loads = registry.measure(*ring);
+
+        long long totalWeight = 0, totalFiles = 0, totalHits = 0;
+        for (int w : weights) totalWeight += w;
+        for (const HostRegistry::HostLoad& load : loads) {
+            totalFiles += load.files;
+            totalHits += load.hits;
+        }
+        double fileMin = 1e9, fileMax = 0, reqMin = 1e9, reqMax = 0;
+        for (size_t i = 0; i < weights.size(); i++) {
+            double weightShare = static_cast<double>(weights[i]) / totalWeight;
+            double fileRatio = (static_cast<double>(loads[i].files) / totalFiles) / weightShare;
+            double reqRatio = (static_cast<double>(loads[i].hits) / totalHits) / weightShare;
+            fileMin = min(fileMin, fileRatio);
+            fileMax = max(fileMax, fileRatio);
+            reqMin = min(reqMin, reqRatio);
+            reqMax = max(reqMax, reqRatio);
+        }
+        ok = ok && totalFiles == numFiles;
+        printRow({ to_string(vnodes), to_string(ring->getMachineCount()), fixedStr(fileMin, 2),
+                   fixedStr(fileMax, 2), fixedStr(reqMin, 2), fixedStr(reqMax, 2) }, widths);
+
+        if (report && vnodes == HostRegistry::DEFAULT_VNODES_PER_WEIGHT) {
+            reportRing = ring;
+            reportRegistry = registry;
+        } else {
+            delete ring;
+        }
+    }
+    printRule(widths);
+
+    if (reportRing != nullptr) {
+        cout << "\n  Per host at " << HostRegistry::DEFAULT_VNODES_PER_WEIGHT << " positions per weight:\n";
+        reportRegistry.printReport(*reportRing);
+        delete reportRing;
+    } else {
+        cout << "  Pass --report for the per-host table at " << HostRegistry::DEFAULT_VNODES_PER_WEIGHT
+             << " positions per weight.\n";
+    }
+    return ok ? 0 : 1;
+}
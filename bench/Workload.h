@@ -0,0 +1,135 @@
+/**
+ * @file Workload.h
+ * @brief Put/get/delete workload generator driven through the quiet IPFS API
+ * @details Gets pick a stored key uniformly or with a Zipf skew over key
+ *          rank; puts add fresh random keys and deletes remove stored ones,
+ *          so the stored set stays roughly constant for balanced mixes.
+ *
+ * Compile: g++ -std=c++17 -O2 -Isrc -o ipfs_bench bench/bench_main.cpp
+ */
+
+#pragma once
+#include <cmath>
+#include <unordered_set>
+#include "BenchUtil.h"
+#include "RingFixture.h"
+
+/**
+ * @brief One client operation
+ */
+struct WorkloadOp {
+    enum Kind { Put, Get, Delete };
+    Kind kind;
+    int key;
+};
+
+/**
+ * @brief Counters of one workload run
+ */
+struct WorkloadStats {
+    long long puts = 0;
+    long long gets = 0;
+    long long deletes = 0;
+    long long misses = 0;       // Gets or deletes that found no file
+    double totalNs = 0;
+
+    long long ops() const { return puts + gets + deletes; }
+    double nsPerOp() const { return ops() > 0 ? totalNs / static_cast<double>(ops()) : 0.0; }
+};
+
+/**
+ * @brief Random operation stream over a live key set
+ */
+class Workload {
+public:
+    vector<int> live;           // Stored keys; index = popularity rank for Zipf gets
+    unordered_set<int> liveSet;
+    double putFraction;
+    double deleteFraction;
+    int bits;
+    vector<double> zipfCdf;     // Empty = uniform gets
+    mt19937_64 rng;
+
+    /**
+     * @param zipfTheta Skew of gets (0 = uniform, ~1 = typical web skew)
+     */
+    Workload(const vector<uint64_t>& stored, int keyBits, double putFrac, double deleteFrac,
+             double zipfTheta, uint64_t seed)
+        : putFraction(putFrac), deleteFraction(deleteFrac), bits(keyBits), rng(seed) {
+        for (uint64_t key : stored) {
+            live.push_back(static_cast<int>(key));
+            liveSet.insert(static_cast<int>(key));
+        }
+        shuffle(live.begin(), live.end(), rng);
+        if (zipfTheta > 0 && !live.empty()) {
+            zipfCdf.resize(live.size());
+            double sum = 0;
+            for (size_t i = 0; i < live.size(); i++) {
+                sum += 1.0 / pow(static_cast<double>(i + 1), zipfTheta);
+                zipfCdf[i] = sum;
+            }
+            for (double& c : zipfCdf) c /= sum;
+        }
+    }
+
+    WorkloadOp next() {
+        double r = static_cast<double>(rng() >> 11) / static_cast<double>(1ULL << 53);
+        if (r < putFraction || live.empty()) {
+            int key;
+            do {
+                key = static_cast<int>(rng() & ((1ULL << bits) - 1));
+            } while (liveSet.count(key) > 0);
+            live.push_back(key);
+            liveSet.insert(key);
+            return { WorkloadOp::Put, key };
+        }
+        if (r < putFraction + deleteFraction) {
+            size_t i = static_cast<size_t>(rng() % live.size());
+            int key = live[i];
+            live[i] = live.back();
+            live.pop_back();
+            liveSet.erase(key);
+            return { WorkloadOp::Delete, key };
+        }
+        return { WorkloadOp::Get, live[pickRank()] };
+    }
+
+private:
+    size_t pickRank() {
+        if (zipfCdf.empty()) return static_cast<size_t>(rng() % live.size());
+        double u = static_cast<double>(rng() >> 11) / static_cast<double>(1ULL << 53);
+        size_t rank = static_cast<size_t>(lower_bound(zipfCdf.begin(), zipfCdf.end(), u) - zipfCdf.begin());
+        return min(rank, live.size() - 1);
+    }
+};
+
+/**
+ * @brief Run ops operations against any store with Put/Get/Delete (e.g. IPFS)
+ */
+template<class Store>
+WorkloadStats runWorkload(Store& store, Workload& workload, size_t ops) {
+    WorkloadStats stats;
+    vector<WorkloadOp> stream;
+    stream.reserve(ops);
+    for (size_t i = 0; i < ops; i++) stream.push_back(workload.next());
+
+    Stopwatch sw;
+    for (const WorkloadOp& op : stream) {
+        switch (op.kind) {
+            case WorkloadOp::Put:
+                stats.puts++;
+                store.Put(op.key, "file_" + to_string(op.key), fileSizeFor(static_cast<uint64_t>(op.key)));
+                break;
+            case WorkloadOp::Get:
+                stats.gets++;
+                if (store.Get(op.key) == nullptr) stats.misses++;
+                break;
+            case WorkloadOp::Delete:
+                stats.deletes++;
+                if (!store.Delete(op.key)) stats.misses++;
+                break;
+        }
+    }
+    stats.totalNs = sw.elapsedNs();
+    return stats;
+}
@@ -0,0 +1,94 @@
+/**
+ * @file bench_main.cpp
+ * @brief IPFS Ring DHT Simulator - benchmark driver
+ * @details Non-interactive benchmarks for the ring data structures.
+ *          Usage: ipfs_bench <scenario> [--option=value ...]
+ * 
+ * Compile: g++ -std=c++17 -O2 -Isrc -o ipfs_bench bench/bench_main.cpp
+ */
+
+#include <iostream>
+#include <string>
+
+#include "BenchUtil.h"
+#include "SuccessorBench.h"
+#include "ConcurrentBench.h"
+#include "BatchBench.h"
+#include "DrainBench.h"
+#include "RebalanceBench.h"
+#include "PlacementBench.h"
+#include "WeightedBench.h"
+#include "EngineBench.h"
+#include "ReplicaBench.h"
+#include "RoutingBench.h"
+#include "FingerBench.h"
+#include "ShortcutBench.h"
+#include "LatencyBench.h"
+#include "CoalesceBench.h"
+#include "AdmissionBench.h"
+#include "NegativeBench.h"
+#include "QuorumBench.h"
+#include "RepairBench.h"
+#include "BlockBench.h"
+
+using namespace std;
+
+/**
+ * @brief Benchmark scenario table
+ */
+struct Scenario {
+    const char* name;
+    const char* description;
+    int (*run)(int argc, char** argv);
+};
+
+static const Scenario scenarios[] = {
+    { "succ", "Successor structures: sorted array vs vEB trie vs bitmap", runSuccessorBench },
+    { "concurrent", "Concurrent joins/leaves/succ: lock-free skip list vs mutex", runConcurrentBench },
+    { "batch", "Scale-out/in: one-by-one joins/leaves vs one batched pass", runBatchBench },
+    { "drain", "Decommission under load: blocking deletekey vs graceful drain", runDrainBench },
+    { "rebalance", "Scale-out under load: synchronous vs throttled rebalancer", runRebalanceBench },
+    { "placement", "Join placement: random IDs vs splitting the most loaded arc", runPlacementBench },
+    { "weighted", "Weighted hosts: file/request share vs capacity weight", runWeightedBench },
+    { "engine", "Placement engines: Chord ring vs jump hash vs Maglev", runEngineBench },
+    { "replica", "Replica placement: successor list vs rendezvous hashing", runReplicaBench },
+    { "routing", "Routing engines: Chord fingers vs Pastry vs Koorde de Bruijn", runRoutingBench },
+    { "fingers", "Chord finger base k: hops vs finger table size", runFingerBench },
+    { "shortcuts", "Learned shortcut links under skewed lookups", runShortcutBench },
+    { "latency", "Tail latency: single vs parallel vs hedged, recursive vs iterative", runLatencyBench },
+    { "coalesce", "Flash crowd: lookups with and without request coalescing", runCoalesceBench },
+    { "admission", "Overload: unbounded queues vs drop / retry / redirect", runAdmissionBench },
+    { "negative", "Miss-heavy retries with and without negative caches", runNegativeBench },
+    { "quorum", "Quorum reads/writes: latency and availability per R/W", runQuorumBench },
+    { "repair", "Replica divergence with and without read repair", runRepairBench },
+    { "blocks", "Block logs: real bytes moved on handoff, compaction", runBlockBench },
+};
+
+void printUsage() {
+    cout << "\n  Usage: ipfs_bench <scenario> [--option=value ...]\n\n";
+    cout << "  Scenarios:\n";
+    for (const Scenario& s : scenarios) {
+        cout << "    " << setw(14) << left << s.name << s.description << "\n";
+    }
+    cout << "    " << setw(14) << left << "all" << "Run every scenario with default options\n\n";
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        printUsage();
+        return 1;
+    }
+
+    string name = argv[1];
+    for (const Scenario& s : scenarios) {
+        if (name == "all" || name == s.name) {
+            int rc = s.run(argc, argv);
+            if (rc != 0 || name != "all") return rc;
+        }
+    }
+    if (name == "all") return 0;
+
+    cout << "\n  Unknown scenario: " << name << "\n";
+    printUsage();
+    return 1;
+}
@@ -0,0 +1,278 @@
+/**
+ * @file AdmissionControl.h
+ * @brief Bounded per-machine request queues with admission control
+ * @details Each machine serves requests one at a time from a FIFO inbound
+ *          queue holding at most queueCapacity requests (waiting plus in
+ *          service). Service times are fixed, exponential or heavy-tailed
+ *          around a configured mean. When a request reaches a full queue the
+ *          admission policy decides what happens:
+ *          - Unbounded: no limit (baseline; latency grows without bound).
+ *          - Drop: the request fails at once.
+ *          - RejectRetry: the client is told to retry after a backoff that
+ *            doubles per attempt, up to maxRetries attempts.
+ *          - Redirect: the request goes to the first replica holder with
+ *            room; it fails if every holder is full.
+ *          The simulator replays timed requests against the ring's real
+ *          owners and replica sets and reports latency, failures and queue
+ *          depth seen by arriving requests, per machine and overall.
+ *
+ * Compile: g++ -std=c++17 -Wall -o ipfs_dht src/main.cpp
+ */
+
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <unordered_map>
+#include <vector>
+#include "CircularLL.h"
+using namespace std;
+
+/**
+ * @brief Distribution of per-request service time
+ */
+enum class ServiceModel {
+    Fixed,          // Always the mean
+    Exponential,    // Memoryless around the mean
+    HeavyTail       // Log-normal (sigma 1) with the same mean
+};
+
+/**
+ * @brief What a full queue does with a new request
+ */
+enum class AdmissionPolicy {
+    Unbounded,      // Accept everything
+    Drop,           // Fail the request
+    RejectRetry,    // Client retries after a doubling backoff
+    Redirect        // Send it to a replica holder with room
+};
+
+/**
+ * @brief Queue, service and admission settings shared by all machines
+ */
+struct AdmissionConfig {
+    AdmissionPolicy policy = AdmissionPolicy::Drop;
+    int queueCapacity = 32;             // Requests waiting or in service per machine
+    ServiceModel service = ServiceModel::Exponential;
+    double serviceUs = 200;             // Mean service time
+    int maxRetries = 3;                 // RejectRetry: attempts after the first
+    double retryBackoffUs = 2000;       // RejectRetry: first backoff, doubled per attempt
+};
+
+/**
+ * @brief Inbound queue of one machine
+ */
+class MachineQueue {
+public:
+    deque<double> departures;   // Finish times of requests in the queue, in order
+    long long arrivals;         // Requests that reached this machine
+    long long admitted;
+    long long refused;          // Turned away because the queue was full
+    long long depthSum;         // Sum of depths seen by arrivals
+    int maxDepth;
+
+    MachineQueue() : arrivals(0), admitted(0), refused(0), depthSum(0), maxDepth(0) {}
+
+    /**
+     * @brief Requests waiting or in service at time now
+     */
+    int depth(double now) {
+        while (!departures.empty() && departures.front() <= now) departures.pop_front();
+        return static_cast<int>(departures.size());
+    }
+
+    /**
+     * @brief Count an arrival; true if there is room for it (capacity <= 0 = unbounded)
+     */
+    bool arrive(double now, int capacity) {
+        int d = depth(now);
+        arrivals++;
+        depthSum += d;
+        maxDepth = max(maxDepth, d);
+        if (capacity > 0 && d >= capacity) {
+            refused++;
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Queue a request behind the ones already there
+     * @return Time it finishes
+     */
+    double admit(double now, double serviceUs) {
+        double start = departures.empty() ? now : max(now, departures.back());
+        departures.push_back(start + serviceUs);
+        admitted++;
+        return start + serviceUs;
+    }
+
+    double meanDepth() const {
+        return arrivals > 0 ? static_cast<double>(depthSum) / static_cast<double>(arrivals) : 0.0;
+    }
+};
+
+/**
+ * @brief Outcome of one simulated run
+ */
+struct AdmissionReport {
+    long long requests = 0;
+    long long served = 0;
+    long long failed = 0;       // Dropped, out of retries or no replica with room
+    long long rejects = 0;      // RejectRetry: rejections (each followed by a retry or failure)
+    long long redirects = 0;    // Served by a replica holder instead of the owner
+    vector<double> latencyUs;   // Served requests, first arrival to finish
+    int maxDepth = 0;           // Deepest queue any arrival saw
+    double meanDepth = 0;       // Average depth seen by arrivals
+    double hotMeanDepth = 0;    // Same, at the machine with the most arrivals
+};
+
+/**
+ * @brief Replays timed requests through bounded machine queues
+ */
+class AdmissionSimulator {
+public:
+    CircularLinkedList* ring;
+    AdmissionConfig config;
+    unordered_map<int, MachineQueue> queues;    // Machine ID -> inbound queue
+
+    AdmissionSimulator(CircularLinkedList* r, const AdmissionConfig& settings, uint64_t seed = 1)
+        : ring(r), config(settings), rng(seed), uniform(0.0, 1.0) {}
+
+    /**
+     * @brief Serve requests given as (arrival time in us, file key), sorted by time
+     */
+    AdmissionReport run(const vector<pair<double, int>>& requests) {
+        AdmissionReport report;
+        queues.clear();
+        int capacity = config.policy == AdmissionPolicy::Unbounded ? 0 : config.queueCapacity;
+
+        priority_queue<Attempt, vector<Attempt>, greater<Attempt>> pending;
+        size_t next = 0;
+        while (next < requests.size() || !pending.empty()) {
+            Attempt a;
+            if (pending.empty() || (next < requests.size() && requests[next].first <= pending.top().time)) {
+                a = { requests[next].first, requests[next].first, requests[next].second, 0 };
+                next++;
+                report.requests++;
+            } else {
+                a = pending.top();
+                pending.pop();
+            }
+
+            CircularNode* owner = ring->ownerOf(a.key);
+            if (owner == nullptr) {
+                report.failed++;
+                continue;
+            }
+            MachineQueue& q = queues[owner->key];
+            if (q.arrive(a.time, capacity)) {
+                report.latencyUs.push_back(q.admit(a.time, serviceTime()) - a.first);
+                report.served++;
+                continue;
+            }
+
+            if (config.policy == AdmissionPolicy::RejectRetry) {
+                report.rejects++;
+                if (a.attempt < config.maxRetries) {
+                    double backoff = config.retryBackoffUs * static_cast<double>(1 << a.attempt) * (0.5 + uniform(rng));
+                    pending.push({ a.time + backoff, a.first, a.key, a.attempt + 1 });
+                } else {
+                    report.failed++;
+                }
+            } else if (config.policy == AdmissionPolicy::Redirect && redirect(a, capacity, report)) {
+                report.redirects++;
+                report.served++;
+            } else {
+                report.failed++;
+            }
+        }
+
+        long long hottest = -1, depthSum = 0, arrivals = 0;
+        for (auto& entry : queues) {
+            MachineQueue& q = entry.second;
+            report.maxDepth = max(report.maxDepth, q.maxDepth);
+            depthSum += q.depthSum;
+            arrivals += q.arrivals;
+            if (q.arrivals > hottest) {
+                hottest = q.arrivals;
+                report.hotMeanDepth = q.meanDepth();
+            }
+        }
+        report.meanDepth = arrivals > 0 ? static_cast<double>(depthSum) / static_cast<double>(arrivals) : 0.0;
+        return report;
+    }
+
+    /**
+     * @brief Print queue metrics of the machines with the most arrivals
+     */
+    void printQueues(int top) const {
+        vector<pair<long long, int>> order;
+        for (const auto& entry : queues) order.push_back({ entry.second.arrivals, entry.first });
+        sort(order.rbegin(), order.rend());
+
+        cout << fixed << setprecision(2);
+        cout << "\n  +============+============+============+============+============+============+\n";
+        cout << "  | Machine    | Arrivals   | Admitted   | Refused    | Mean depth | Max depth  |\n";
+        cout << "  +------------+------------+------------+------------+------------+------------+\n";
+        for (size_t i = 0; i < order.size() && i < static_cast<size_t>(top); i++) {
+            const MachineQueue& q = queues.at(order[i].second);
+            cout << "  | " << setw(10) << left << order[i].second
+                 << " | " << setw(10) << q.arrivals
+                 << " | " << setw(10) << q.admitted
+                 << " | " << setw(10) << q.refused
+                 << " | " << setw(10) << q.meanDepth()
+                 << " | " << setw(10) << q.maxDepth << " |\n";
+        }
+        cout << "  +============+============+============+============+============+============+\n";
+        cout << defaultfloat << setprecision(6) << left;
+    }
+
+private:
+    /**
+     * @brief One try of a request: first arrival time kept for its latency
+     */
+    struct Attempt {
+        double time;
+        double first;
+        int key;
+        int attempt;
+
+        bool operator>(const Attempt& other) const { return time > other.time; }
+    };
+
+    mt19937_64 rng;
+    uniform_real_distribution<double> uniform;
+
+    double serviceTime() {
+        switch (config.service) {
+            case ServiceModel::Fixed:
+                return config.serviceUs;
+            case ServiceModel::Exponential:
+                return -config.serviceUs * log(1.0 - uniform(rng));
+            case ServiceModel::HeavyTail: {
+                normal_distribution<double> normal(log(config.serviceUs) - 0.5, 1.0);
+                return exp(normal(rng));
+            }
+        }
+        return config.serviceUs;
+    }
+
+    /**
+     * @brief Queue the request at the first replica holder with room
+     */
+    bool redirect(const Attempt& a, int capacity, AdmissionReport& report) {
+        for (CircularNode* holder : ring->replicaSet(a.key)) {
+            MachineQueue& q = queues[holder->key];
+            if (q.arrive(a.time, capacity)) {
+                report.latencyUs.push_back(q.admit(a.time, serviceTime()) - a.first);
+                return true;
+            }
+        }
+        return false;
+    }
+};
@@ -21,9 +21,15 @@ class FileNode {
 public:
     int key;
     string path;
+    long long size;     // Bytes (0 = unknown), used to budget transfers
+    long long hits;     // Successful lookups, moves with the file
+    long long version;  // Lamport version under quorum replication (0 = unversioned)
+    int segment;        // Block log segment holding the bytes (-1 = none)
+    long long offset;   // Record offset in that segment
     
-    FileNode() : key(-1), path("") {}
-    FileNode(int k, const string& p) : key(k), path(p) {}
+    FileNode() : key(-1), path(""), size(0), hits(0), version(0), segment(-1), offset(0) {}
+    FileNode(int k, const string& p, long long bytes = 0)
+        : key(k), path(p), size(bytes), hits(0), version(0), segment(-1), offset(0) {}
 };
 
 /**
@@ -236,6 +242,33 @@ public:
         return files;
     }
 
+    /**
+     * @brief Get up to limit files (breadth-first), for chunked transfers
+     */
+    vector<FileNode> getFiles(BTreeNode* node, size_t limit) {
+        vector<FileNode> files;
+        if (node == nullptr || limit == 0) return files;
+
+        Queue<BTreeNode*> q;
+        q.enqueue(node);
+
+        while (!q.is_empty() && files.size() < limit) {
+            BTreeNode* current = q.peek();
+            q.dequeue();
+
+            for (int i = 1; i <= current->count && files.size() < limit; i++) {
+                files.push_back(current->value[i]);
+            }
+
+            for (int i = 0; i <= current->count; i++) {
+                if (current->child[i] != nullptr) {
+                    q.enqueue(current->child[i]);
+                }
+            }
+        }
+        return files;
+    }
+
     BTreeNode* insert(FileNode file, BTreeNode* node, int ord) {
         FileNode promoted;
         BTreeNode* newChild;
@@ -503,4 +536,20 @@ public:
         }
         return nullptr;
     }
+
+    /**
+     * @brief File with the smallest key greater than after, or nullptr (O(log F))
+     * @details Lets a caller walk a key range one file at a time and resume later
+     */
+    FileNode* findNextFile(int after) {
+        FileNode* best = nullptr;
+        BTreeNode* node = root;
+        while (node != nullptr) {
+            int i = 1;
+            while (i <= node->count && node->value[i].key <= after) i++;
+            if (i <= node->count) best = &node->value[i];
+            node = node->child[i - 1];
+        }
+        return best;
+    }
 };
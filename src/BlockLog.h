@@ -0,0 +1,377 @@
+/**
+ * @file BlockLog.h
+ * @brief Append-only, log-structured store for the bytes of a machine's files
+ * @details Each machine appends file contents to segment files in its own
+ *          directory. A record is a 16-byte header (key, length) followed by
+ *          the bytes. The machine's B-tree is the index: a FileNode keeps
+ *          the segment and offset of its record, and size is the length.
+ *          Reads are positioned reads (pread), so they never move a shared
+ *          file pointer. When the active segment reaches the segment size it
+ *          is sealed and a new one starts. Releasing a record (file deleted
+ *          or handed to another machine) only counts its bytes as dead. A
+ *          sealed segment that is at least half dead is compacted: its live
+ *          records are copied to the active segment, their index entries are
+ *          updated and the segment file is removed. Closing the log removes
+ *          the machine's segments.
+ *
+ * Compile: g++ -std=c++17 -Wall -o ipfs_dht src/main.cpp
+ */
+
+#pragma once
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <string>
+#include <sys/stat.h>
+#include <vector>
+#ifdef _WIN32
+#include <direct.h>
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+#include "BTree.h"
+using namespace std;
+
+// ============================================================================
+// Positioned file I/O (pread / pwrite; seek + read / write on Windows)
+// ============================================================================
+
+inline int blockOpen(const string& path) {
+#ifdef _WIN32
+    return _open(path.c_str(), _O_RDWR | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+    return open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+#endif
+}
+
+inline void blockClose(int fd) {
+#ifdef _WIN32
+    _close(fd);
+#else
+    close(fd);
+#endif
+}
+
+/**
+ * @brief Read exactly n bytes at offset
+ */
+inline bool blockPread(int fd, char* buffer, long long n, long long offset) {
+    while (n > 0) {
+#ifdef _WIN32
+        if (_lseeki64(fd, offset, SEEK_SET) < 0) return false;
+        long long got = _read(fd, buffer, static_cast<unsigned int>(n > (1 << 30) ? (1 << 30) : n));
+#else
+        long long got = pread(fd, buffer, static_cast<size_t>(n), static_cast<off_t>(offset));
+#endif
+        if (got <= 0) return false;
+        buffer += got;
+        offset += got;
+        n -= got;
+    }
+    return true;
+}
+
+/**
+ * @brief Write exactly n bytes at offset
+ */
+inline bool blockPwrite(int fd, const char* buffer, long long n, long long offset) {
+    while (n > 0) {
+#ifdef _WIN32
+        if (_lseeki64(fd, offset, SEEK_SET) < 0) return false;
+        long long put = _write(fd, buffer, static_cast<unsigned int>(n > (1 << 30) ? (1 << 30) : n));
+#else
+        long long put = pwrite(fd, buffer, static_cast<size_t>(n), static_cast<off_t>(offset));
+#endif
+        if (put <= 0) return false;
+        buffer += put;
+        offset += put;
+        n -= put;
+    }
+    return true;
+}
+
+inline void blockUnlink(const string& path) {
+#ifdef _WIN32
+    _unlink(path.c_str());
+#else
+    unlink(path.c_str());
+#endif
+}
+
+inline bool blockMkdir(const string& path) {
+#ifdef _WIN32
+    return _mkdir(path.c_str()) == 0 || errno == EEXIST;
+#else
+    return mkdir(path.c_str(), 0755) == 0 || errno == EEXIST;
+#endif
+}
+
+inline void blockRmdir(const string& path) {
+#ifdef _WIN32
+    _rmdir(path.c_str());
+#else
+    rmdir(path.c_str());
+#endif
+}
+
+/**
+ * @brief Block log counters, summed over machines by the ring
+ */
+struct BlockStats {
+    long long bytesAppended;
+    long long bytesRead;
+    long long bytesCompacted;
+    long long bytesHandedIn;
+    long long diskBytes;
+    long long deadBytes;
+    long long segmentsCompacted;
+    long long ioErrors;
+};
+
+/**
+ * @brief Segmented append-only log of one machine's file bytes
+ */
+class BlockLog {
+public:
+    static constexpr long long DEFAULT_SEGMENT_BYTES = 4LL << 20;
+    static constexpr long long HEADER_BYTES = 16;
+    static constexpr double COMPACT_DEAD_SHARE = 0.5;   // Sealed segments at least this dead are compacted
+
+    long long bytesAppended;    // Record bytes written (headers included)
+    long long bytesRead;        // File bytes read back
+    long long bytesCompacted;   // Live bytes copied out of compacted segments
+    long long bytesHandedIn;    // File bytes received from other machines' logs
+    int segmentsCompacted;
+    int ioErrors;
+
+    BlockLog() : bytesAppended(0), bytesRead(0), bytesCompacted(0), bytesHandedIn(0), segmentsCompacted(0), ioErrors(0),
+                 segmentBytes(DEFAULT_SEGMENT_BYTES) {}
+
+    BlockLog(const BlockLog&) = delete;
+    BlockLog& operator=(const BlockLog&) = delete;
+
+    ~BlockLog() { close(); }
+
+    bool isOpen() const { return !directory.empty(); }
+
+    /**
+     * @brief Generated contents for a file known only by its size (repeatable per key)
+     */
+    static string payloadFor(int key, long long size) {
+        string data(static_cast<size_t>(size > 0 ? size : 0), '\0');
+        uint64_t x = static_cast<uint64_t>(key) * 0x9E3779B97F4A7C15ULL + 1;
+        for (size_t i = 0; i < data.size(); i += sizeof(x)) {
+            x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+            memcpy(&data[i], &x, min(sizeof(x), data.size() - i));
+        }
+        return data;
+    }
+
+    /**
+     * @brief Start an empty log in dir (created if missing)
+     */
+    bool open(const string& dir, long long bytesPerSegment = DEFAULT_SEGMENT_BYTES) {
+        close();
+        if (!blockMkdir(dir)) {
+            ioErrors++;
+            return false;
+        }
+        directory = dir;
+        segmentBytes = bytesPerSegment > 0 ? bytesPerSegment : DEFAULT_SEGMENT_BYTES;
+        return true;
+    }
+
+    /**
+     * @brief Close and remove every segment and the directory
+     */
+    void close() {
+        for (Segment& s : segments) dropSegment(s);
+        segments.clear();
+        if (!directory.empty()) blockRmdir(directory);
+        directory.clear();
+    }
+
+    /**
+     * @brief Bytes held on disk, live and dead
+     */
+    long long diskBytes() const {
+        long long total = 0;
+        for (const Segment& s : segments) total += s.size;
+        return total;
+    }
+
+    long long deadBytes() const {
+        long long total = 0;
+        for (const Segment& s : segments) total += s.dead;
+        return total;
+    }
+
+    /**
+     * @brief Append data as the record of file; sets file's segment, offset and size
+     */
+    bool append(FileNode& file, const string& data) {
+        if (!isOpen()) return false;
+        long long length = static_cast<long long>(data.size());
+        Segment* active = activeSegment(HEADER_BYTES + length);
+        if (active == nullptr) {
+            ioErrors++;
+            return false;
+        }
+        char header[HEADER_BYTES] = {};
+        int32_t key = file.key;
+        memcpy(header, &key, sizeof(key));
+        memcpy(header + 8, &length, sizeof(length));
+        long long offset = active->size;
+        if (!blockPwrite(active->fd, header, HEADER_BYTES, offset) ||
+            !blockPwrite(active->fd, data.data(), length, offset + HEADER_BYTES)) {
+            ioErrors++;
+            return false;
+        }
+        active->size += HEADER_BYTES + length;
+        bytesAppended += HEADER_BYTES + length;
+        file.segment = static_cast<int>(active - segments.data());
+        file.offset = offset;
+        file.size = length;
+        return true;
+    }
+
+    /**
+     * @brief Read file's bytes into data
+     * @return False if the file has no record here or the record does not match
+     */
+    bool read(const FileNode& file, string& data) {
+        const Segment* s = segmentOf(file);
+        if (s == nullptr) return false;
+        char header[HEADER_BYTES];
+        if (!blockPread(s->fd, header, HEADER_BYTES, file.offset)) {
+            ioErrors++;
+            return false;
+        }
+        int32_t key;
+        long long length;
+        memcpy(&key, header, sizeof(key));
+        memcpy(&length, header + 8, sizeof(length));
+        if (key != file.key || length != file.size) return false;
+        data.resize(static_cast<size_t>(length));
+        if (length > 0 && !blockPread(s->fd, &data[0], length, file.offset + HEADER_BYTES)) {
+            ioErrors++;
+            return false;
+        }
+        bytesRead += length;
+        return true;
+    }
+
+    /**
+     * @brief The file's record is no longer referenced by the index
+     */
+    void release(FileNode& file) {
+        Segment* s = segmentOf(file);
+        if (s != nullptr) s->dead += HEADER_BYTES + file.size;
+        file.segment = -1;
+        file.offset = 0;
+    }
+
+    /**
+     * @brief True if some sealed segment is dead enough to compact
+     */
+    bool wantsCompaction() const {
+        for (const Segment& s : segments) {
+            if (isCompactable(s)) return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Copy the live records of dead-enough sealed segments forward
+     * @param index B-tree whose FileNodes point into this log
+     * @return Segments removed
+     */
+    int compact(BTree& index) {
+        int removed = 0;
+        for (size_t i = 0; i < segments.size(); i++) {
+            if (!isCompactable(segments[i])) continue;
+            for (long long offset = 0; offset < segments[i].size;) {
+                char header[HEADER_BYTES];
+                if (!blockPread(segments[i].fd, header, HEADER_BYTES, offset)) {
+                    ioErrors++;
+                    break;
+                }
+                int32_t key;
+                long long length;
+                memcpy(&key, header, sizeof(key));
+                memcpy(&length, header + 8, sizeof(length));
+
+                // Live only if the index still points at this record
+                FileNode* file = index.findFile(key);
+                if (file != nullptr && file->segment == static_cast<int>(i) && file->offset == offset) {
+                    string data;
+                    if (read(*file, data)) {
+                        bytesRead -= length;
+                        bytesCompacted += length;
+                        append(*file, data);
+                    }
+                }
+                offset += HEADER_BYTES + length;
+            }
+            dropSegment(segments[i]);
+            segmentsCompacted++;
+            removed++;
+        }
+        return removed;
+    }
+
+private:
+    /**
+     * @brief One segment file; an empty path marks a compacted slot
+     */
+    struct Segment {
+        int fd;
+        string path;
+        long long size;     // Bytes written
+        long long dead;     // Bytes of released records
+        bool sealed;
+    };
+
+    string directory;               // Empty while closed
+    long long segmentBytes;
+    vector<Segment> segments;       // Index = segment number in FileNode::segment
+
+    bool isCompactable(const Segment& s) const {
+        return s.sealed && s.fd >= 0 && s.size > 0 && s.dead >= COMPACT_DEAD_SHARE * s.size;
+    }
+
+    Segment* segmentOf(const FileNode& file) {
+        if (file.segment < 0 || file.segment >= static_cast<int>(segments.size())) return nullptr;
+        Segment* s = &segments[static_cast<size_t>(file.segment)];
+        return s->fd >= 0 ? s : nullptr;
+    }
+
+    /**
+     * @brief Segment to append a record of bytes to; seals a full one first
+     */
+    Segment* activeSegment(long long bytes) {
+        if (!segments.empty()) {
+            Segment& last = segments.back();
+            if (!last.sealed && (last.size == 0 || last.size + bytes <= segmentBytes)) return &last;
+            last.sealed = true;
+        }
+        string path = directory + "/segment_" + to_string(segments.size()) + ".log";
+        int fd = blockOpen(path);
+        if (fd < 0) return nullptr;
+        segments.push_back({ fd, path, 0, 0, false });
+        return &segments.back();
+    }
+
+    void dropSegment(Segment& s) {
+        if (s.fd < 0) return;
+        blockClose(s.fd);
+        blockUnlink(s.path);
+        s.fd = -1;
+        s.size = 0;
+        s.dead = 0;
+    }
+};
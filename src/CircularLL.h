@@ -3,7 +3,7 @@
  * @brief Circular Linked List implementation for the Ring DHT
  * @details Implements the ring of machines with routing tables and file storage
  * 
- * Compile: g++ -std=c++17 -Wall -o ipfs_dht src/*.cpp
+ * Compile: g++ -std=c++17 -Wall -pthread -o ipfs_dht src/*.cpp
  */
 
 #pragma once
@@ -11,12 +11,27 @@
 #include <iomanip>
 #include <algorithm>
 #include <set>
+#include <unordered_map>
 #include <vector>
 #include <string>
 #include <cmath>
+#include <mutex>
 #include "Queue.h"
 #include "DoublyLL.h"
 #include "BTree.h"
+#include "OwnerTable.h"
+#include "OccupancyBitmap.h"
+#include "SuccessorTrie.h"
+#include "LockFreeSkipList.h"
+#include "Rebalancer.h"
+#include "PlacementEngine.h"
+#include "ReplicaSelector.h"
+#include "ShortcutCache.h"
+#include "SingleFlight.h"
+#include "KoordeRouter.h"
+#include "NegativeCache.h"
+#include "BlockLog.h"
+#include "PastryRouter.h"
 
 using namespace std;
 
@@ -28,115 +43,242 @@ public:
     int key;                              // Machine ID
     CircularNode* next;                   // Next machine in ring
     DoublyLinkedList<CircularNode> RT;    // Routing Table (Finger Table)
+    DoublyLinkedList<CircularNode> CCW;   // Counter-clockwise fingers (bidirectional routing only)
+    ShortcutCache shortcuts;              // Owners this machine's own lookups often end at
+    NegativeCache misses;                 // Keys this machine's own lookups recently found missing
     BTree BTreeroot;                      // B-Tree for file storage
+    BTree replicaStore;                   // Copies of files whose primary is another machine
+    BlockLog blocks;                      // Bytes of the files in BTreeroot (block store only)
+    bool draining;                        // Leaving: still linked, streaming files to successor
 
-    CircularNode() : key(-1), next(nullptr) {
+    CircularNode() : key(-1), next(nullptr), draining(false) {
         RT.setHead(nullptr);
         RT.setTail(nullptr);
     }
     
-    CircularNode(int v) : key(v), next(nullptr) {
+    CircularNode(int v) : key(v), next(nullptr), draining(false) {
         RT.setHead(nullptr);
         RT.setTail(nullptr);
     }
     
-    CircularNode(int v, int btreeOrder) : key(v), next(nullptr), BTreeroot(btreeOrder) {
+    CircularNode(int v, int btreeOrder)
+        : key(v), next(nullptr), BTreeroot(btreeOrder), replicaStore(btreeOrder), draining(false) {
         RT.setHead(nullptr);
         RT.setTail(nullptr);
     }
 };
 
 // Forward declarations
-void Traverse_delete(CircularNode* source, CircularNode* destination, int order);
-void Traverse_insert(CircularNode* previous, int order, int identifierSpace);
+void Traverse_delete(CircularNode* source, CircularNode* destination, int order, bool verbose = true);
+void Traverse_insert(CircularNode* previous, int order, int identifierSpace, bool verbose = true,
+                     const CircularNode* rangeStart = nullptr);
+
+/**
+ * @brief Hand file's bytes from source's block log to destination's
+ * @details Updates file's segment and offset; call before inserting file
+ *          into destination's B-tree. No-op when the block store is off.
+ */
+inline void moveBlock(CircularNode* source, CircularNode* destination, FileNode& file) {
+    if (!source->blocks.isOpen() || !destination->blocks.isOpen() || file.segment < 0) return;
+    string data;
+    if (!source->blocks.read(file, data)) return;
+    source->blocks.release(file);
+    if (destination->blocks.append(file, data)) destination->blocks.bytesHandedIn += file.size;
+}
+
+/**
+ * @brief Compact machine's log once released records leave a segment half dead
+ */
+inline void compactBlocks(CircularNode* machine) {
+    if (machine->blocks.wantsCompaction()) machine->blocks.compact(machine->BTreeroot);
+}
 
 /**
  * @brief Transfer all files from source to destination machine
  */
-void Traverse_delete(CircularNode* source, CircularNode* destination, int order) {
+void Traverse_delete(CircularNode* source, CircularNode* destination, int order, bool verbose) {
     if (source->BTreeroot.root == nullptr) return;
     
     vector<FileNode> files = source->BTreeroot.getAllFiles(source->BTreeroot.root);
     
-    cout << "\n  Transferring " << files.size() << " file(s) from Machine " 
-         << source->key << " to Machine " << destination->key << ":\n";
+    if (verbose) {
+        cout << "\n  Transferring " << files.size() << " file(s) from Machine " 
+             << source->key << " to Machine " << destination->key << ":\n";
+    }
     
-    for (const FileNode& file : files) {
+    for (FileNode file : files) {
+        moveBlock(source, destination, file);
         destination->BTreeroot.insertHelper(file, order);
-        cout << "    - File " << file.key << " (" << file.path << ") transferred\n";
+        if (verbose) cout << "    - File " << file.key << " (" << file.path << ") transferred\n";
     }
 }
 
 /**
  * @brief Redistribute files to newly inserted machine
+ * @param rangeStart Start of the new machine's range if it differs from
+ *        previous (previous is draining and its files already moved on)
  */
-void Traverse_insert(CircularNode* previous, int order, int /*identifierSpace*/) {
+void Traverse_insert(CircularNode* previous, int order, int /*identifierSpace*/, bool verbose,
+                     const CircularNode* rangeStart) {
     CircularNode* newMachine = previous->next;
-    CircularNode* successor = newMachine->next;
-    
-    if (successor->BTreeroot.root == nullptr) return;
+    int fromKey = rangeStart != nullptr ? rangeStart->key : previous->key;
     
-    vector<FileNode> files = successor->BTreeroot.getAllFiles(successor->BTreeroot.root);
-    vector<FileNode> toMove;
-    
-    // Find files that should move to new machine
-    for (const FileNode& file : files) {
-        // File belongs to new machine if: previous->key < file.key <= newMachine->key
-        // Handle wrap-around
-        bool shouldMove = false;
-        if (previous->key < newMachine->key) {
-            shouldMove = (file.key > previous->key && file.key <= newMachine->key);
-        } else {
-            // Wrap around case
-            shouldMove = (file.key > previous->key || file.key <= newMachine->key);
-        }
-        
-        if (shouldMove) {
-            toMove.push_back(file);
-        }
-    }
-    
-    if (!toMove.empty()) {
-        cout << "\n  Redistributing " << toMove.size() << " file(s) to new Machine " 
-             << newMachine->key << ":\n";
-        
-        for (const FileNode& file : toMove) {
-            newMachine->BTreeroot.insertHelper(file, order);
-            successor->BTreeroot.deleteHelper(file.key);
-            cout << "    - File " << file.key << " (" << file.path << ") moved from Machine " 
-                 << successor->key << "\n";
+    // A draining successor may already have streamed part of the range onwards
+    for (CircularNode* successor = newMachine->next; successor != newMachine; successor = successor->next) {
+        if (successor->BTreeroot.root != nullptr) {
+            vector<FileNode> files = successor->BTreeroot.getAllFiles(successor->BTreeroot.root);
+            vector<FileNode> toMove;
+            
+            // Find files that should move to new machine
+            for (const FileNode& file : files) {
+                // File belongs to new machine if: fromKey < file.key <= newMachine->key
+                // Handle wrap-around
+                bool shouldMove = false;
+                if (fromKey < newMachine->key) {
+                    shouldMove = (file.key > fromKey && file.key <= newMachine->key);
+                } else {
+                    // Wrap around case
+                    shouldMove = (file.key > fromKey || file.key <= newMachine->key);
+                }
+                
+                if (shouldMove) {
+                    toMove.push_back(file);
+                }
+            }
+            
+            if (!toMove.empty()) {
+                if (verbose) {
+                    cout << "\n  Redistributing " << toMove.size() << " file(s) to new Machine " 
+                         << newMachine->key << ":\n";
+                }
+                
+                for (FileNode& file : toMove) {
+                    moveBlock(successor, newMachine, file);
+                    newMachine->BTreeroot.insertHelper(file, order);
+                    successor->BTreeroot.deleteHelper(file.key);
+                    if (verbose) {
+                        cout << "    - File " << file.key << " (" << file.path << ") moved from Machine " 
+                             << successor->key << "\n";
+                    }
+                }
+                compactBlocks(successor);
+            }
         }
+        if (!successor->draining) break;
     }
 }
 
+/**
+ * @brief Per-machine routing state used by routeToKey()
+ */
+enum class RoutingMode {
+    Chord,      // Finger tables (RT): succ(n + 2^i)
+    Pastry,     // Prefix routing tables + leaf sets (PastryRouter)
+    Koorde      // Successor + 2^c de Bruijn pointers (KoordeRouter)
+};
+
+/**
+ * @brief Load measure used to pick where a new machine should join
+ */
+enum class LoadMetric {
+    KeySpace,   // Size of each machine's arc of the identifier space
+    Files,      // Files stored (B-tree count)
+    Requests    // Lookup hits of the stored files
+};
+
+/**
+ * @brief Suggested ID for a joining machine
+ */
+struct JoinProposal {
+    int id;             // -1 if no arc can be split
+    int splits;         // Machine whose arc the new ID splits
+    long long load;     // Load of that machine before the join
+    long long moved;    // Load the new machine takes over
+};
+
+/**
+ * @brief One client lookup in a concurrent batch
+ */
+struct LookupRequest {
+    int origin;         // Machine the client asked
+    int key;            // File key
+};
+
+/**
+ * @brief Work done by one searchFiles() batch
+ */
+struct CoalesceStats {
+    long long requests = 0;
+    long long routes = 0;       // routeToKey() calls
+    long long descents = 0;     // B-tree searches at the owner
+    long long cachedMisses = 0; // Answered "not found" by the origin's negative cache
+};
+
 /**
  * @brief Circular Linked List (Ring) for DHT
  */
 class CircularLinkedList {
 public:
+    static constexpr int MAX_FINGER_BASE = 16;
+
     CircularNode* head;
     int identifierSpace;  // 2^bits (total number of possible IDs)
     int bits;             // Number of bits in identifier space
     int btreeOrder;       // B-tree order for file storage
+    OwnerTable<CircularNode> ownerTable;  // Optional direct-mapped owner[id] table
+    OccupancyBitmap occupancy;            // Optional bitmap of machine IDs for succ/pred
+    SuccessorTrie trie;                   // Optional O(log log U) successor structure
+    unordered_map<int, CircularNode*> nodeIndex;  // Machine ID -> node
+    ConcurrentRing<int> members;          // Machine IDs; lock-free successorId()/predecessorId() during joins and leaves
+    recursive_mutex membershipLock;       // Serializes joins and leaves from concurrent threads
+    bool verbose;         // Print membership progress (file transfers, success lines)
+    set<int> drainingIds;  // Machines migrating their files before leaving
+    Rebalancer rebalancer;   // Optional throttled background handoff after joins
+    PlacementEngine placement;  // Optional jump / Maglev placement instead of successor arcs
+    ReplicaSelector replicas;   // Optional extra copies of every file
+    RoutingMode routing;        // Routing state used by routeToKey()
+    int fingerBase;             // Chord fingers at n + j*k^i, 1 <= j < k (k = 2: n + 2^i)
+    bool bidirectional;         // Also keep fingers at pred(n - j*k^i) and route both ways
+    int shortcutSlots;          // Learned shortcut links per machine (0 = off)
+    bool coalesceLookups;       // searchFiles(): identical in-flight lookups share one route / descent
+    int negativeSlots;          // Cached misses per origin machine (0 = off)
+    long long membershipEpoch;  // Bumped on every join, leave or placement change
+    unordered_map<int, vector<int>> missWatchers;  // Key -> origins caching its miss (this epoch)
+    PastryRouter pastry;        // Prefix tables and leaf sets (RoutingMode::Pastry)
+    KoordeRouter koorde;        // de Bruijn pointers (RoutingMode::Koorde)
+    string blockDir;            // Block store root, one log directory per machine ("" = off)
+    long long blockSegmentBytes;    // Segment size of every machine's log
 
-    CircularLinkedList() : head(nullptr), identifierSpace(16), bits(4), btreeOrder(5) {}
+    CircularLinkedList()
+        : head(nullptr), identifierSpace(16), bits(4), btreeOrder(5), verbose(true), routing(RoutingMode::Chord),
+          fingerBase(2), bidirectional(false), shortcutSlots(0), coalesceLookups(true),
+          negativeSlots(0), membershipEpoch(0), blockSegmentBytes(BlockLog::DEFAULT_SEGMENT_BYTES) {
+        occupancy.init(identifierSpace);
+    }
     
-    CircularLinkedList(int IS, int order = 5) : head(nullptr), btreeOrder(order) {
+    CircularLinkedList(int IS, int order = 5)
+        : head(nullptr), btreeOrder(order), verbose(true), routing(RoutingMode::Chord),
+          fingerBase(2), bidirectional(false), shortcutSlots(0), coalesceLookups(true),
+          negativeSlots(0), membershipEpoch(0), blockSegmentBytes(BlockLog::DEFAULT_SEGMENT_BYTES) {
         identifierSpace = IS;
         bits = static_cast<int>(log2(IS));
+        if (IS > 0 && bits <= OccupancyBitmap::AUTO_BITS) {
+            occupancy.init(identifierSpace);
+        }
     }
 
     ~CircularLinkedList() {
-        if (head == nullptr) return;
-        
-        CircularNode* current = head->next;
-        while (current != head) {
-            CircularNode* next = current->next;
-            delete current;
-            current = next;
+        if (head != nullptr) {
+            CircularNode* current = head->next;
+            while (current != head) {
+                CircularNode* next = current->next;
+                delete current;
+                current = next;
+            }
+            delete head;
+            head = nullptr;
         }
-        delete head;
-        head = nullptr;
+        if (!blockDir.empty()) blockRmdir(blockDir);    // Machine logs removed themselves
     }
 
     CircularNode* getHead() { return head; }
@@ -147,31 +289,91 @@ public:
 
     bool isEmpty() { return head == nullptr; }
 
+    bool isDirectMapped() const { return ownerTable.isEnabled(); }
+
+    /**
+     * @brief Precompute owner[id] for every ID (only for bits <= OwnerTable::MAX_BITS)
+     * @return false if the identifier space is too large
+     */
+    bool enableDirectMapping() {
+        if (bits > OwnerTable<CircularNode>::MAX_BITS) return false;
+        if (!ownerTable.enable(identifierSpace)) return false;
+        ownerTable.rebuild(head);
+        return true;
+    }
+
+    void disableDirectMapping() {
+        ownerTable.disable();
+    }
+
     int getMachineCount() {
-        if (head == nullptr) return 0;
-        int count = 1;
-        CircularNode* current = head->next;
-        while (current != head) {
-            count++;
-            current = current->next;
+        return static_cast<int>(nodeIndex.size());
+    }
+
+    bool hasOccupancyBitmap() const { return occupancy.isEnabled(); }
+
+    /**
+     * @brief Keep machine IDs in a rank/select bitmap (2^bits / 8 bytes)
+     * @details Enabled automatically up to OccupancyBitmap::AUTO_BITS
+     */
+    bool enableOccupancyBitmap() {
+        if (identifierSpace <= 0 || !occupancy.init(identifierSpace)) return false;
+        for (const auto& entry : nodeIndex) {
+            occupancy.set(entry.first);
         }
-        return count;
+        return true;
+    }
+
+    void disableOccupancyBitmap() {
+        occupancy.release();
+    }
+
+    bool hasSuccessorTrie() const { return trie.isEnabled(); }
+
+    /**
+     * @brief Serve succ/pred from a layered-bitmap vEB trie
+     * @details Memory grows with machine count, not identifier space, so it
+     *          suits wide ID spaces with many machines. Takes precedence over
+     *          the occupancy bitmap when both are enabled.
+     */
+    void enableSuccessorTrie() {
+        int keyBits = 1;
+        while ((1LL << keyBits) < identifierSpace) keyBits++;
+        trie.init(keyBits);
+        for (const auto& entry : nodeIndex) {
+            trie.insert(static_cast<uint64_t>(entry.first));
+        }
+    }
+
+    void disableSuccessorTrie() {
+        trie.release();
     }
 
     /**
      * @brief Insert machine in sorted order
      */
     void insert(int value) {
+        lock_guard<recursive_mutex> guard(membershipLock);
         CircularNode* newNode = new CircularNode(value, btreeOrder);
-        newNode->RT.initialize(value, identifierSpace);
+        newNode->RT.initialize(value, identifierSpace, fingerBase);
+        newNode->shortcuts.resize(shortcutSlots);
+        newNode->misses.resize(negativeSlots);
+        if (!blockDir.empty()) openBlocks(newNode);
+        nodeIndex[value] = newNode;
+        members.join(value, value);
+        bumpEpoch();
+        if (occupancy.isEnabled()) occupancy.set(value);
+        if (trie.isEnabled()) trie.insert(static_cast<uint64_t>(value));
 
         if (head == nullptr) {
             head = newNode;
             newNode->next = newNode;
+            if (ownerTable.isEnabled()) ownerTable.onJoin(newNode, newNode);
             return;
         }
 
         // Insert in sorted order
+        CircularNode* pred;
         if (value < head->key) {
             // Insert before head
             CircularNode* tail = head;
@@ -181,6 +383,7 @@ public:
             newNode->next = head;
             tail->next = newNode;
             head = newNode;
+            pred = tail;
         } else {
             CircularNode* current = head;
             while (current->next != head && current->next->key < value) {
@@ -188,13 +391,17 @@ public:
             }
             newNode->next = current->next;
             current->next = newNode;
+            pred = current;
         }
+
+        if (ownerTable.isEnabled()) ownerTable.onJoin(newNode, pred);
     }
 
     /**
      * @brief Insert machine with validation and file redistribution
      */
     void insertAfter(int value, int order) {
+        lock_guard<recursive_mutex> guard(membershipLock);
         if (search(value)) {
             cout << "\n  ERROR: Machine " << value << " already exists!\n";
             return;
@@ -209,36 +416,262 @@ public:
         updateRT();
         
         CircularNode* prev = SearchNewMachine(value);
-        if (prev != nullptr && getMachineCount() > 1) {
-            Traverse_insert(prev, order, identifierSpace);
+        if (placement.isEnabled()) {
+            placement.update({ value }, {});
+            int moved = rehomeFiles(order);
+            if (verbose) cout << "\n  " << moved << " file(s) moved to their new " << placement.name() << " owner.\n";
+        } else if (prev != nullptr && getMachineCount() > 1) {
+            // Files already drained past a leaving predecessor belong to the new machine too
+            CircularNode* rangeStart = prev;
+            while (rangeStart->draining && rangeStart->key != value) {
+                rangeStart = findPredecessor(rangeStart->key);
+            }
+            if (rebalancer.isEnabled()) {
+                queueHandoff(prev, rangeStart);
+            } else {
+                Traverse_insert(prev, order, identifierSpace, verbose, rangeStart);
+            }
+        }
+        if (replicas.isEnabled()) {
+            replicas.update({ value }, {});
+            refreshReplicas(order);
         }
         
-        cout << "\n  Machine " << value << " added successfully!\n";
+        if (verbose) cout << "\n  Machine " << value << " added successfully!\n";
     }
 
     /**
-     * @brief Search for machine by ID
+     * @brief Queue the range the new machine after previous should receive,
+     *        for the background rebalancer to move (same range as Traverse_insert)
+     * @details O(1) in the number of files: the rebalancer scans the range
+     *          incrementally, so the join itself touches no B-tree.
      */
-    bool search(int value) {
-        if (head == nullptr) return false;
-        
+    void queueHandoff(CircularNode* previous, const CircularNode* rangeStart) {
+        CircularNode* newMachine = previous->next;
+        int fromKey = rangeStart != nullptr ? rangeStart->key : previous->key;
+
+        vector<int> sources;
+        for (CircularNode* source = newMachine->next; source != newMachine; source = source->next) {
+            sources.push_back(source->key);
+            if (!source->draining) break;
+        }
+        rebalancer.queueRange(fromKey, newMachine->key, sources);
+        if (verbose) {
+            cout << "\n  Queued range (" << fromKey << ", " << newMachine->key << "] for background move to Machine "
+                 << newMachine->key << ".\n";
+        }
+    }
+
+    /**
+     * @brief Move one file (index entry and bytes) from holder to owner
+     */
+    void transferFile(CircularNode* holder, CircularNode* owner, int fileKey, int order) {
+        FileNode* file = holder->BTreeroot.findFile(fileKey);
+        if (file == nullptr) return;
+        FileNode copy = *file;
+        moveBlock(holder, owner, copy);
+        owner->BTreeroot.insertHelper(copy, order);
+        holder->BTreeroot.deleteHelper(fileKey);
+        compactBlocks(holder);
+    }
+
+    /**
+     * @brief Enable throttled background handoff for joins (<= 0 = unlimited)
+     */
+    void enableRebalancer(double bytesPerSecond, double filesPerSecond) {
+        rebalancer.enable(bytesPerSecond, filesPerSecond);
+    }
+
+    /**
+     * @brief Let the rebalancer move files for the given elapsed time
+     * @return Number of files moved
+     */
+    int rebalanceStep(double seconds, int order) {
+        return rebalancer.step(*this, seconds, order);
+    }
+
+    /**
+     * @brief Choose how keys map to machines and move every file to its new owner
+     * @details Jump and Maglev resolve a key in O(1) and route in one hop;
+     *          Ring restores successor arcs. Not available while draining.
+     */
+    bool setPlacement(PlacementMode mode, int order) {
+        if (isDraining()) {
+            cout << "\n  ERROR: Finish draining before changing the placement mode!\n";
+            return false;
+        }
+        rebalancer.flush(*this, order);
+
+        placement.enable(mode, machineIds());
+        bumpEpoch();
+        int moved = rehomeFiles(order);
+        if (replicas.isEnabled()) refreshReplicas(order);
+        if (verbose) {
+            cout << "\n  Placement: " << placement.name() << ", " << moved << " file(s) moved.\n";
+        }
+        return true;
+    }
+
+    /**
+     * @brief IDs of all machines in ring order
+     */
+    vector<int> machineIds() {
+        vector<int> ids;
+        if (head != nullptr) {
+            CircularNode* current = head;
+            do {
+                ids.push_back(current->key);
+                current = current->next;
+            } while (current != head);
+        }
+        return ids;
+    }
+
+    /**
+     * @brief Keep factor copies of every file: the primary plus factor - 1 replicas
+     * @details SuccessorList uses the machines after the owner; Rendezvous and
+     *          Skeleton use HRW, so membership changes move fewer replicas.
+     * @return Number of replica copies created
+     */
+    int enableReplication(ReplicaMode mode, int factor, int order) {
+        replicas.configure(mode, factor, machineIds());
+        int copied = refreshReplicas(order);
+        if (verbose) {
+            cout << "\n  Replication: " << replicas.name() << ", " << replicas.factor << " copies per file, "
+                 << copied << " replica(s) created.\n";
+        }
+        return copied;
+    }
+
+    /**
+     * @brief Machines that should hold a replica of key (primary excluded)
+     */
+    vector<CircularNode*> replicaSet(int key) {
+        vector<CircularNode*> result;
+        CircularNode* primary = head != nullptr ? ownerOf(key) : nullptr;
+        if (!replicas.isEnabled() || primary == nullptr) return result;
+
+        size_t want = static_cast<size_t>(replicas.factor - 1);
+        if (replicas.mode == ReplicaMode::SuccessorList) {
+            for (CircularNode* m = primary->next; m != primary && result.size() < want; m = m->next) {
+                if (!m->draining) result.push_back(m);
+            }
+        } else {
+            for (int id : replicas.select(key, want, primary->key)) {
+                result.push_back(findMachineById(id));
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Copy a newly stored file to its replica set
+     */
+    void storeReplicas(const FileNode& file, int order) {
+        for (CircularNode* machine : replicaSet(file.key)) {
+            if (!machine->replicaStore.searchFile(file.key)) machine->replicaStore.insertHelper(file, order);
+        }
+    }
+
+    void dropReplicas(int fileKey) {
+        for (CircularNode* machine : replicaSet(fileKey)) {
+            machine->replicaStore.deleteHelper(fileKey);
+        }
+    }
+
+    /**
+     * @brief Reconcile every replica store with the current replica sets
+     * @details Creates missing copies from the primaries and deletes copies
+     *          on machines that left a file's replica set. O(F * R) selections.
+     * @return Number of replica copies created (moved) by the change
+     */
+    int refreshReplicas(int order) {
+        if (head == nullptr) return 0;
+        unordered_map<int, vector<int>> desired;
+        int created = 0;
+
         CircularNode* current = head;
         do {
-            if (current->key == value) return true;
+            if (current->BTreeroot.root != nullptr && replicas.isEnabled()) {
+                for (const FileNode& file : current->BTreeroot.getAllFiles(current->BTreeroot.root)) {
+                    vector<int>& holders = desired[file.key];
+                    for (CircularNode* machine : replicaSet(file.key)) {
+                        holders.push_back(machine->key);
+                        if (!machine->replicaStore.searchFile(file.key)) {
+                            machine->replicaStore.insertHelper(file, order);
+                            created++;
+                        }
+                    }
+                }
+            }
             current = current->next;
         } while (current != head);
-        
-        return false;
+
+        do {
+            if (current->replicaStore.root != nullptr) {
+                for (const FileNode& file : current->replicaStore.getAllFiles(current->replicaStore.root)) {
+                    auto it = desired.find(file.key);
+                    if (it == desired.end() || find(it->second.begin(), it->second.end(), current->key) == it->second.end()) {
+                        current->replicaStore.deleteHelper(file.key);
+                    }
+                }
+            }
+            current = current->next;
+        } while (current != head);
+        return created;
+    }
+
+    /**
+     * @brief Owner of a key under the current placement mode
+     */
+    CircularNode* ownerOf(int key) {
+        return placement.isEnabled() ? findMachineById(placement.ownerOf(key)) : succ(key);
+    }
+
+    /**
+     * @brief Move every file not stored on ownerOf(key)
+     * @details Jump and Maglev owners are not contiguous arcs, so after a
+     *          membership change every machine is checked, not just neighbours.
+     * @return Number of files moved
+     */
+    int rehomeFiles(int order) {
+        if (head == nullptr) return 0;
+        int moved = 0;
+        CircularNode* current = head;
+        do {
+            if (current->BTreeroot.root != nullptr) {
+                for (FileNode file : current->BTreeroot.getAllFiles(current->BTreeroot.root)) {
+                    CircularNode* owner = ownerOf(file.key);
+                    if (owner == nullptr || owner == current) continue;
+                    moveBlock(current, owner, file);
+                    owner->BTreeroot.insertHelper(file, order);
+                    current->BTreeroot.deleteHelper(file.key);
+                    moved++;
+                }
+                compactBlocks(current);
+            }
+            current = current->next;
+        } while (current != head);
+        return moved;
+    }
+
+    /**
+     * @brief Search for machine by ID
+     */
+    bool search(int value) {
+        return nodeIndex.count(value) > 0;
     }
 
     /**
      * @brief Delete machine and redistribute files
      */
     void deletekey(int value, int order) {
+        lock_guard<recursive_mutex> guard(membershipLock);
         if (head == nullptr) {
             cout << "\n  ERROR: Ring is empty!\n";
             return;
         }
+        rebalancer.flush(*this, order);  // Handoffs assume every file is at its owner
 
         CircularNode* current = head;
         CircularNode* previous = nullptr;
@@ -261,11 +694,25 @@ public:
             return;
         }
         
-        // Transfer files to successor
+        // Transfer files to successor (or wherever the placement engine now maps them)
         CircularNode* successor = current->next;
-        if (current->next != current) {  // More than one machine
-            Traverse_delete(current, successor, order);
+        if (placement.isEnabled()) {
+            placement.update({}, { value });
+            int moved = rehomeFiles(order);
+            if (verbose) cout << "\n  " << moved << " file(s) moved to their new " << placement.name() << " owner.\n";
+        } else if (current->next != current) {  // More than one machine
+            Traverse_delete(current, successor, order, verbose);
+        }
+
+        if (ownerTable.isEnabled()) {
+            ownerTable.onLeave(current, previous != nullptr ? previous : tail, successor);
         }
+        nodeIndex.erase(value);
+        members.leave(value);
+        drainingIds.erase(value);
+        bumpEpoch();
+        if (occupancy.isEnabled()) occupancy.reset(value);
+        if (trie.isEnabled()) trie.erase(static_cast<uint64_t>(value));
         
         // Remove from ring
         if (current == head) {
@@ -276,17 +723,373 @@ public:
                 head = head->next;
                 tail->next = head;
             }
-        } else {
-            previous->next = current->next;
-        }
-        
-        delete current;
-        
-        if (head != nullptr) {
-            updateRT();
+        } else {
+            previous->next = current->next;
+        }
+        
+        delete current;
+        
+        if (head != nullptr) {
+            updateRT();
+        }
+        if (replicas.isEnabled()) {
+            replicas.update({}, { value });
+            refreshReplicas(order);
+        }
+        
+        if (verbose) cout << "\n  Machine " << value << " removed successfully!\n";
+    }
+
+    /**
+     * @brief Apply many joins and leaves as one membership change
+     * @details Computes the new ring once, then a single sweep over the old
+     *          machines finds every arc whose owner changes: leaving machines
+     *          hand over all files, surviving machines only the files that
+     *          fall outside their new arc (new predecessor, self]. Routing
+     *          tables are rebuilt once at the end.
+     * @return Number of files moved
+     */
+    int applyMembershipBatch(const vector<int>& joins, const vector<int>& leaves, int order) {
+        lock_guard<recursive_mutex> guard(membershipLock);
+
+        // Validate and de-duplicate
+        set<int> leaving(drainingIds.begin(), drainingIds.end());  // Finish pending drains too
+        for (int id : leaves) {
+            if (search(id)) {
+                leaving.insert(id);
+            } else {
+                cout << "\n  WARNING: Machine " << id << " not found, leave skipped.\n";
+            }
+        }
+        set<int> joining;
+        for (int id : joins) {
+            if (id < 0 || id >= identifierSpace) {
+                cout << "\n  WARNING: Machine ID " << id << " is out of range, join skipped.\n";
+            } else if (search(id)) {
+                cout << "\n  WARNING: Machine " << id << " already exists, join skipped.\n";
+            } else {
+                joining.insert(id);
+            }
+        }
+        if (joining.empty() && leaving.empty()) return 0;
+        rebalancer.flush(*this, order);
+
+        // Old ring in sorted order, new ring by merging survivors with joins
+        vector<CircularNode*> oldRing;
+        if (head != nullptr) {
+            CircularNode* current = head;
+            do {
+                oldRing.push_back(current);
+                current = current->next;
+            } while (current != head);
+        }
+
+        vector<CircularNode*> newRing;
+        newRing.reserve(oldRing.size() - leaving.size() + joining.size());
+        auto joinIt = joining.begin();
+        for (CircularNode* machine : oldRing) {
+            while (joinIt != joining.end() && *joinIt < machine->key) {
+                newRing.push_back(new CircularNode(*joinIt++, btreeOrder));
+            }
+            if (leaving.count(machine->key) == 0) newRing.push_back(machine);
+        }
+        while (joinIt != joining.end()) {
+            newRing.push_back(new CircularNode(*joinIt++, btreeOrder));
+        }
+        if (!blockDir.empty()) {
+            for (CircularNode* machine : newRing) {
+                if (!machine->blocks.isOpen()) openBlocks(machine);
+            }
+        }
+
+        if (newRing.empty() && verbose) {
+            cout << "\n  WARNING: Batch removes every machine; stored files are discarded.\n";
+        }
+
+        vector<int> newIds;
+        newIds.reserve(newRing.size());
+        for (CircularNode* machine : newRing) newIds.push_back(machine->key);
+        if (placement.isEnabled()) {
+            placement.update(vector<int>(joining.begin(), joining.end()), vector<int>(leaving.begin(), leaving.end()));
+        }
+
+        // New owner of a key: first new ID >= key, wrapping to the smallest
+        auto successorIn = [&](int key) -> CircularNode* {
+            size_t i = static_cast<size_t>(lower_bound(newIds.begin(), newIds.end(), key) - newIds.begin());
+            return newRing[i == newRing.size() ? 0 : i];
+        };
+        auto newOwner = [&](int key) -> CircularNode* {
+            return successorIn(placement.isEnabled() ? placement.ownerOf(key) : key);
+        };
+
+        // One sweep over the old ring: move files of every arc that changed owner
+        int moved = 0;
+        size_t n = oldRing.size();
+        for (size_t i = 0; i < n && !newRing.empty(); i++) {
+            CircularNode* machine = oldRing[i];
+            bool isLeaving = leaving.count(machine->key) > 0;
+            if (!isLeaving && !placement.isEnabled()) {
+                // A survivor only loses keys if a joining machine now precedes it
+                size_t pos = static_cast<size_t>(lower_bound(newIds.begin(), newIds.end(), machine->key) - newIds.begin());
+                CircularNode* newPred = newRing[(pos + newRing.size() - 1) % newRing.size()];
+                if (joining.count(newPred->key) == 0) continue;
+            }
+            if (machine->BTreeroot.root == nullptr) continue;
+
+            vector<FileNode> files = machine->BTreeroot.getAllFiles(machine->BTreeroot.root);
+            for (FileNode& file : files) {
+                CircularNode* owner = newOwner(file.key);
+                if (owner == machine) continue;
+                moveBlock(machine, owner, file);
+                owner->BTreeroot.insertHelper(file, order);
+                if (!isLeaving) machine->BTreeroot.deleteHelper(file.key);
+                moved++;
+            }
+            if (!isLeaving) compactBlocks(machine);
+        }
+
+        // Relink the ring and update the indexes
+        for (size_t i = 0; i < newRing.size(); i++) {
+            newRing[i]->next = newRing[(i + 1) % newRing.size()];
+        }
+        head = newRing.empty() ? nullptr : newRing[0];
+
+        for (int id : joining) {
+            CircularNode* machine = successorIn(id);
+            machine->shortcuts.resize(shortcutSlots);
+            machine->misses.resize(negativeSlots);
+            nodeIndex[id] = machine;
+            members.join(id, id);
+            if (occupancy.isEnabled()) occupancy.set(id);
+            if (trie.isEnabled()) trie.insert(static_cast<uint64_t>(id));
+        }
+        for (int id : leaving) {
+            delete nodeIndex[id];
+            nodeIndex.erase(id);
+            members.leave(id);
+            drainingIds.erase(id);
+            if (occupancy.isEnabled()) occupancy.reset(id);
+            if (trie.isEnabled()) trie.erase(static_cast<uint64_t>(id));
+        }
+        if (ownerTable.isEnabled()) ownerTable.rebuild(head);
+        bumpEpoch();
+
+        if (head != nullptr) updateRT();
+        if (replicas.isEnabled()) {
+            replicas.update(vector<int>(joining.begin(), joining.end()), vector<int>(leaving.begin(), leaving.end()));
+            refreshReplicas(order);
+        }
+
+        if (verbose) {
+            cout << "\n  Batch applied: " << joining.size() << " join(s), " << leaving.size()
+                 << " leave(s), " << moved << " file(s) moved, routing tables rebuilt once.\n";
+        }
+        return moved;
+    }
+
+    /**
+     * @brief Start a graceful leave: the machine keeps serving while drainStep()
+     *        streams its files to the next non-draining machine
+     */
+    bool beginDrain(int value) {
+        CircularNode* machine = findMachineById(value);
+        if (machine == nullptr) {
+            cout << "\n  ERROR: Machine " << value << " not found!\n";
+            return false;
+        }
+        if (machine->draining) {
+            cout << "\n  WARNING: Machine " << value << " is already draining.\n";
+            return false;
+        }
+        if (placement.isEnabled()) {
+            cout << "\n  ERROR: Graceful drain follows ring arcs; not available with " << placement.name()
+                 << " placement.\n";
+            return false;
+        }
+        if (getMachineCount() - drainingIds.size() <= 1) {
+            cout << "\n  ERROR: Cannot drain the last serving machine!\n";
+            return false;
+        }
+
+        rebalancer.flush(*this, btreeOrder);
+        machine->draining = true;
+        drainingIds.insert(value);
+        if (verbose) {
+            cout << "\n  Machine " << value << " is draining "
+                 << machine->BTreeroot.countFiles(machine->BTreeroot.root) << " file(s) to Machine "
+                 << drainTarget(machine)->key << ".\n";
+        }
+        return true;
+    }
+
+    bool isDraining() const { return !drainingIds.empty(); }
+
+    /**
+     * @brief First machine at or after this one that is not draining
+     * @details Writes for a draining machine's range go here
+     */
+    CircularNode* drainTarget(CircularNode* machine) {
+        CircularNode* current = machine;
+        while (current->draining) {
+            current = current->next;
+            if (current == machine) return nullptr;  // Everyone is draining
+        }
+        return current;
+    }
+
+    /**
+     * @brief Move up to maxFiles files of a draining machine to its target;
+     *        unlink the machine once it is empty
+     * @return Number of files moved
+     */
+    int drainStep(int value, int maxFiles, int order) {
+        CircularNode* machine = findMachineById(value);
+        if (machine == nullptr || !machine->draining) return 0;
+        CircularNode* target = drainTarget(machine);
+        if (target == nullptr) return 0;
+
+        vector<FileNode> chunk = machine->BTreeroot.getFiles(machine->BTreeroot.root,
+                                                             static_cast<size_t>(maxFiles));
+        for (FileNode& file : chunk) {
+            moveBlock(machine, target, file);
+            target->BTreeroot.insertHelper(file, order);
+            machine->BTreeroot.deleteHelper(file.key);
+        }
+        compactBlocks(machine);
+
+        if (machine->BTreeroot.root == nullptr || machine->BTreeroot.root->count == 0) {
+            deletekey(value, order);  // Nothing left to transfer
+        }
+        return static_cast<int>(chunk.size());
+    }
+
+    /**
+     * @brief Advance every drain by one chunk
+     * @return Number of files moved
+     */
+    int pumpDrains(int maxFiles, int order) {
+        int moved = 0;
+        vector<int> ids(drainingIds.begin(), drainingIds.end());
+        for (int id : ids) {
+            moved += drainStep(id, maxFiles, order);
+        }
+        return moved;
+    }
+
+    /**
+     * @brief Machine currently holding a file, or nullptr
+     * @details Checks the responsible machine, then (if it is draining) the
+     *          machines its files are being streamed to, then the machine a
+     *          queued rebalancer move still has to take the file from.
+     */
+    CircularNode* locateFile(CircularNode* responsible, int fileKey) {
+        CircularNode* current = responsible;
+        while (true) {
+            if (current->BTreeroot.searchFile(fileKey)) return current;
+            if (!current->draining) break;
+            current = current->next;
+            if (current == responsible) break;
+        }
+
+        // Not moved yet by the background rebalancer
+        if (!rebalancer.isIdle()) {
+            for (int id : rebalancer.holdersOf(fileKey)) {
+                CircularNode* holder = findMachineById(id);
+                if (holder != nullptr && holder->BTreeroot.searchFile(fileKey)) return holder;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Propose a join ID that splits the most loaded arc in half
+     * @details KeySpace takes the midpoint of the largest arc. Files and
+     *          Requests pick the machine with the highest load and place the
+     *          new ID at the weighted median key of its arc, so the newcomer
+     *          takes over about half of that load (falls back to the arc
+     *          midpoint when the machine holds no load).
+     */
+    JoinProposal proposeJoinId(LoadMetric metric) {
+        JoinProposal best = { -1, -1, -1, 0 };
+        if (head == nullptr) return { 0, -1, 0, 0 };
+        if (getMachineCount() >= identifierSpace) return best;
+
+        // Most loaded machine and its predecessor
+        CircularNode* pred = head;
+        while (pred->next != head) pred = pred->next;
+        CircularNode* target = nullptr;
+        CircularNode* targetPred = nullptr;
+        CircularNode* current = head;
+        do {
+            long long load = arcLength(pred, current);
+            if (metric != LoadMetric::KeySpace && current->BTreeroot.root != nullptr) {
+                load = 0;
+                for (const FileNode& file : current->BTreeroot.getAllFiles(current->BTreeroot.root)) {
+                    load += (metric == LoadMetric::Files) ? 1 : file.hits;
+                }
+            } else if (metric != LoadMetric::KeySpace) {
+                load = 0;
+            }
+            // Ties (e.g. no load anywhere) go to the larger arc
+            if (load > best.load || (load == best.load && target != nullptr &&
+                                     arcLength(pred, current) > arcLength(targetPred, target))) {
+                best.load = load;
+                target = current;
+                targetPred = pred;
+            }
+            pred = current;
+            current = current->next;
+        } while (current != head);
+
+        long long arc = arcLength(targetPred, target);
+        if (arc < 2) return { -1, -1, -1, 0 };   // Nothing left to split
+        best.splits = target->key;
+
+        // Weighted median of the files in (targetPred, target]
+        if (metric != LoadMetric::KeySpace && best.load > 0) {
+            vector<pair<long long, long long>> byOffset;   // (offset from pred, weight)
+            for (const FileNode& file : target->BTreeroot.getAllFiles(target->BTreeroot.root)) {
+                long long weight = (metric == LoadMetric::Files) ? 1 : file.hits;
+                if (weight > 0) byOffset.push_back({ offsetAfter(targetPred, file.key), weight });
+            }
+            sort(byOffset.begin(), byOffset.end());
+
+            // Prefix split that leaves the smaller of the two halves as large as possible
+            long long taken = 0;
+            long long bestWorst = best.load + 1;
+            for (const auto& entry : byOffset) {
+                if (entry.first >= arc) break;          // Would collide with the target itself
+                taken += entry.second;
+                long long worst = max(taken, best.load - taken);
+                if (worst < bestWorst) {
+                    bestWorst = worst;
+                    best.id = static_cast<int>((targetPred->key + entry.first) % identifierSpace);
+                    best.moved = taken;
+                }
+            }
+            if (best.id >= 0) return best;
         }
-        
-        cout << "\n  Machine " << value << " removed successfully!\n";
+
+        // Midpoint of the arc
+        best.id = static_cast<int>((targetPred->key + arc / 2) % identifierSpace);
+        best.moved = (metric == LoadMetric::KeySpace) ? arc / 2 : 0;
+        return best;
+    }
+
+    /**
+     * @brief Number of IDs in the arc (pred, machine]
+     */
+    long long arcLength(const CircularNode* pred, const CircularNode* machine) const {
+        if (pred == machine) return identifierSpace;
+        return offsetAfter(pred, machine->key);
+    }
+
+    /**
+     * @brief Distance from pred's ID forward to key (1..identifierSpace)
+     */
+    long long offsetAfter(const CircularNode* pred, int key) const {
+        long long d = (static_cast<long long>(key) - pred->key + identifierSpace) % identifierSpace;
+        return d == 0 ? identifierSpace : d;
     }
 
     /**
@@ -302,6 +1105,7 @@ public:
         CircularNode* current = head;
         do {
             cout << current->key;
+            if (current->draining) cout << " (draining)";
             current = current->next;
             if (current != head) cout << " -> ";
         } while (current != head);
@@ -319,6 +1123,18 @@ public:
              << ")                    |\n";
         cout << "  |  Number of Machines: " << setw(5) << left << getMachineCount() 
              << "                               |\n";
+        if (placement.isEnabled()) {
+            cout << "  |  Placement: " << setw(10) << left << placement.name()
+                 << " (O(1) lookup, one-hop routing)      |\n";
+        }
+        if (replicas.isEnabled()) {
+            cout << "  |  Replication: " << setw(14) << left << replicas.name() << " x" << replicas.factor
+                 << "                            |\n";
+        }
+        if (!rebalancer.isIdle()) {
+            cout << "  |  Rebalancing: " << setw(8) << left << rebalancer.pendingCount()
+                 << " range(s) queued, " << setw(8) << left << rebalancer.filesMoved << " moved        |\n";
+        }
         cout << "  +------------------------------------------------------------+\n";
         
         if (head == nullptr) {
@@ -328,19 +1144,51 @@ public:
             do {
                 int fileCount = current->BTreeroot.countFiles(current->BTreeroot.root);
                 cout << "  |  Machine " << setw(5) << left << current->key 
-                     << " | Files: " << setw(5) << left << fileCount << "                         |\n";
+                     << " | Files: " << setw(5) << left << fileCount
+                     << (current->draining ? " | DRAINING              |\n" : "                         |\n");
                 current = current->next;
             } while (current != head);
         }
         cout << "  +============================================================+\n";
     }
 
+    /**
+     * @brief ID of the machine responsible for key, or -1 if the ring is empty
+     * @details Lock-free: safe to call from any thread while other threads
+     *          join or leave. succ() and routing still expect no concurrent
+     *          membership change.
+     */
+    int successorId(int key) const {
+        const ConcurrentRing<int>::Node* node = members.succ(key);
+        return node != nullptr ? node->value : -1;
+    }
+
+    /**
+     * @brief ID of the machine preceding key, or -1 (lock-free, like successorId)
+     */
+    int predecessorId(int key) const {
+        const ConcurrentRing<int>::Node* node = members.pred(key);
+        return node != nullptr ? node->value : -1;
+    }
+
     /**
      * @brief Find successor of a key
      */
     CircularNode* succ(int value) {
         if (head == nullptr) return nullptr;
         
+        if (trie.isEnabled()) {
+            uint64_t id = trie.successor(static_cast<uint64_t>(value));
+            if (id == SuccessorTrie::NONE) id = trie.minimum();  // Wrap around
+            return nodeIndex[static_cast<int>(id)];
+        }
+        
+        if (occupancy.isEnabled()) {
+            int64_t id = occupancy.successor(value);
+            if (id < 0) id = occupancy.successor(0);  // Wrap around
+            return nodeIndex[static_cast<int>(id)];
+        }
+        
         CircularNode* current = head;
         do {
             if (current->key >= value) {
@@ -360,26 +1208,244 @@ public:
         if (head == nullptr) return;
         
         CircularNode* current = head;
+        if (routing != RoutingMode::Chord) {
+            // Finger tables are only read by Chord routing; drop them to save memory
+            do {
+                current->RT.clear();
+                current->CCW.clear();
+                current = current->next;
+            } while (current != head);
+            if (routing == RoutingMode::Pastry) pastry.rebuild(machineIds());
+            if (routing == RoutingMode::Koorde) koorde.rebuild(machineIds());
+            return;
+        }
+        vector<int> sortedIds = bidirectional ? machineIds() : vector<int>();
+
         do {
             // Clear and reinitialize routing table
             current->RT.clear();
-            current->RT.initialize(current->key, identifierSpace);
+            current->RT.initialize(current->key, identifierSpace, fingerBase);
             
             // Update finger table entries
             DoublyNode<CircularNode>* finger = current->RT.head;
-            int i = 0;
             while (finger != nullptr) {
-                // FT[i] = succ(n + 2^i) where n is current machine's key
-                int target = (current->key + (1 << i)) % identifierSpace;
-                finger->filekey = target;
-                CircularNode* succNode = succ(target);
+                // FT = succ(n + j*k^i) where n is current machine's key
+                CircularNode* succNode = succ(finger->filekey);
                 finger->m = succNode;
                 finger->machinekey = succNode ? succNode->key : -1;
                 finger = finger->next;
-                i++;
             }
+            current->RT.mergeRuns();
+
+            // Counter-clockwise: FT' = pred(n - j*k^i), the last machine at or before the target
+            current->CCW.clear();
+            if (bidirectional) {
+                current->CCW.initialize(current->key, identifierSpace, fingerBase, true);
+                for (finger = current->CCW.head; finger != nullptr; finger = finger->next) {
+                    auto it = upper_bound(sortedIds.begin(), sortedIds.end(), finger->filekey);
+                    int predKey = it == sortedIds.begin() ? sortedIds.back() : *(it - 1);
+                    finger->m = nodeIndex[predKey];
+                    finger->machinekey = predKey;
+                }
+                current->CCW.mergeRuns();
+            }
+            current = current->next;
+        } while (current != head);
+    }
+
+    /**
+     * @brief Lay Chord fingers out in base k: (k-1) per level at n + j*k^i,
+     *        for about log_k N hops at (k-1)*log_k(2^bits) entries per machine
+     */
+    void setFingerBase(int base) {
+        fingerBase = max(2, min(base, MAX_FINGER_BASE));
+        updateRT();
+    }
+
+    /**
+     * @brief Keep counter-clockwise fingers too, so Chord routing can reach
+     *        keys just behind a machine without going around the ring
+     */
+    void setBidirectional(bool enabled) {
+        bidirectional = enabled;
+        updateRT();
+    }
+
+    /**
+     * @brief Let every machine learn up to slots shortcut links from the
+     *        owners its own Chord lookups end at (0 turns them off)
+     */
+    void setShortcuts(int slots) {
+        shortcutSlots = max(0, min(slots, ShortcutCache::MAX_SLOTS));
+        if (head == nullptr) return;
+        CircularNode* current = head;
+        do {
+            current->shortcuts.resize(shortcutSlots);
+            if (shortcutSlots == 0) current->shortcuts.clear();
+            current = current->next;
+        } while (current != head);
+    }
+
+    /**
+     * @brief Let every machine cache up to slots recent not-found answers of
+     *        its own lookups (0 turns the negative cache off)
+     */
+    void setNegativeCache(int slots) {
+        negativeSlots = max(0, min(slots, NegativeCache::MAX_SLOTS));
+        missWatchers.clear();
+        if (head == nullptr) return;
+        CircularNode* current = head;
+        do {
+            current->misses.resize(negativeSlots);
+            current->misses.clear();
+            current = current->next;
+        } while (current != head);
+    }
+
+    /**
+     * @brief Keep the bytes of every primary file in per-machine block logs
+     *        under dir (created if missing); files already stored get
+     *        generated contents of their size
+     * @return Files written to the logs, or -1 if dir cannot be created
+     */
+    int enableBlockStore(const string& dir, long long segmentBytes = BlockLog::DEFAULT_SEGMENT_BYTES) {
+        if (!blockMkdir(dir)) return -1;
+        blockDir = dir;
+        blockSegmentBytes = segmentBytes;
+        int written = 0;
+        if (head == nullptr) return written;
+        CircularNode* current = head;
+        do {
+            openBlocks(current);
+            if (current->BTreeroot.root != nullptr) {
+                for (const FileNode& file : current->BTreeroot.getAllFiles(current->BTreeroot.root)) {
+                    FileNode* stored = current->BTreeroot.findFile(file.key);
+                    if (current->blocks.append(*stored, BlockLog::payloadFor(file.key, file.size))) written++;
+                }
+            }
+            current = current->next;
+        } while (current != head);
+        return written;
+    }
+
+    void openBlocks(CircularNode* machine) {
+        machine->blocks.open(blockDir + "/machine_" + to_string(machine->key), blockSegmentBytes);
+    }
+
+    /**
+     * @brief Append file's bytes (data, or generated contents of file.size) to machine's log
+     */
+    void storeBlock(CircularNode* machine, FileNode& file, const string* data) {
+        if (!machine->blocks.isOpen()) return;
+        machine->blocks.append(file, data != nullptr ? *data : BlockLog::payloadFor(file.key, file.size));
+    }
+
+    /**
+     * @brief The machine's copy of fileKey is about to leave its B-tree
+     */
+    void releaseBlock(CircularNode* machine, int fileKey) {
+        FileNode* file = machine->blocks.isOpen() ? machine->BTreeroot.findFile(fileKey) : nullptr;
+        if (file != nullptr) machine->blocks.release(*file);
+    }
+
+    /**
+     * @brief Read a file's bytes from its holder's block log
+     */
+    bool readFile(int fileKey, string& data) {
+        CircularNode* owner = head != nullptr ? ownerOf(fileKey) : nullptr;
+        CircularNode* holder = owner != nullptr ? locateFile(owner, fileKey) : nullptr;
+        FileNode* file = holder != nullptr ? holder->BTreeroot.findFile(fileKey) : nullptr;
+        return file != nullptr && holder->blocks.read(*file, data);
+    }
+
+    /**
+     * @brief Block log counters summed over every machine
+     */
+    BlockStats blockStats() const {
+        BlockStats total = {};
+        if (head == nullptr) return total;
+        const CircularNode* current = head;
+        do {
+            const BlockLog& log = current->blocks;
+            total.bytesAppended += log.bytesAppended;
+            total.bytesRead += log.bytesRead;
+            total.bytesCompacted += log.bytesCompacted;
+            total.bytesHandedIn += log.bytesHandedIn;
+            total.diskBytes += log.diskBytes();
+            total.deadBytes += log.deadBytes();
+            total.segmentsCompacted += log.segmentsCompacted;
+            total.ioErrors += log.ioErrors;
             current = current->next;
         } while (current != head);
+        return total;
+    }
+
+    /**
+     * @brief Membership or placement changed: every cached miss is stale
+     */
+    void bumpEpoch() {
+        membershipEpoch++;
+        missWatchers.clear();
+    }
+
+    /**
+     * @brief True if origin has a current cached miss for key
+     */
+    bool cachedMiss(CircularNode* origin, int key) {
+        return origin->misses.isEnabled() && origin->misses.contains(key, membershipEpoch);
+    }
+
+    /**
+     * @brief Cache a not-found answer at origin and note it for invalidation
+     */
+    void rememberMiss(CircularNode* origin, int key) {
+        if (!origin->misses.isEnabled()) return;
+        int evicted = origin->misses.remember(key, membershipEpoch);
+        if (evicted >= 0) unwatchMiss(evicted, origin->key);
+        vector<int>& watchers = missWatchers[key];
+        if (find(watchers.begin(), watchers.end(), origin->key) == watchers.end()) watchers.push_back(origin->key);
+    }
+
+    /**
+     * @brief Key was inserted: drop its cached miss at every origin holding one
+     */
+    void invalidateMiss(int key) {
+        auto it = missWatchers.find(key);
+        if (it == missWatchers.end()) return;
+        for (int id : it->second) {
+            CircularNode* origin = findMachineById(id);
+            if (origin != nullptr) origin->misses.forget(key);
+        }
+        missWatchers.erase(it);
+    }
+
+    /**
+     * @brief Origin evicted its miss for key: stop tracking it there
+     */
+    void unwatchMiss(int key, int originId) {
+        auto it = missWatchers.find(key);
+        if (it == missWatchers.end()) return;
+        vector<int>& watchers = it->second;
+        auto w = find(watchers.begin(), watchers.end(), originId);
+        if (w != watchers.end()) {
+            *w = watchers.back();
+            watchers.pop_back();
+        }
+        if (watchers.empty()) missWatchers.erase(it);
+    }
+
+    /**
+     * @brief Route with finger tables (Chord), prefix tables + leaf sets
+     *        (Pastry) or de Bruijn pointers (Koorde), then rebuild that state
+     * @param digitBits Pastry digit size b (base 2^b) or Koorde shift c (degree 2^c)
+     */
+    void setRouting(RoutingMode mode, int digitBits = PastryRouter::DEFAULT_DIGIT_BITS) {
+        routing = mode;
+        pastry.disable();
+        koorde.disable();
+        if (mode == RoutingMode::Pastry) pastry.enable(digitBits, PastryRouter::DEFAULT_LEAF_SET, bits);
+        if (mode == RoutingMode::Koorde) koorde.enable(digitBits, bits);
+        updateRT();
     }
 
     /**
@@ -392,38 +1458,34 @@ public:
         if (head == nullptr) return path;
         
         // Find starting machine
-        CircularNode* current = head;
-        do {
-            if (current->key == startMachineId) break;
-            current = current->next;
-        } while (current != head);
+        CircularNode* current = findMachineById(startMachineId);
         
-        if (current->key != startMachineId) {
+        if (current == nullptr) {
             cout << "  ERROR: Starting machine " << startMachineId << " not found!\n";
             return path;
         }
         
         path.push_back(current->key);
+        if (placement.isEnabled()) {
+            // Every machine holds the same table: one hop straight to the owner
+            int owner = placement.ownerOf(key);
+            if (owner != current->key) path.push_back(owner);
+            return path;
+        }
+        if (routing == RoutingMode::Pastry) {
+            return pastry.route(current->key, key);
+        }
+        if (routing == RoutingMode::Koorde) {
+            return koorde.route(current->key, key);
+        }
+        CircularNode* origin = current;
         set<int> visited;
         visited.insert(current->key);
         
         // Route using finger table
         while (true) {
             // Check if current machine is responsible
-            CircularNode* pred = findPredecessor(current->key);
-            int predKey = pred ? pred->key : -1;
-            
-            bool responsible = false;
-            if (getMachineCount() == 1) {
-                responsible = true;
-            } else if (predKey < current->key) {
-                responsible = (key > predKey && key <= current->key);
-            } else {
-                // Wrap around case
-                responsible = (key > predKey || key <= current->key);
-            }
-            
-            if (responsible) {
+            if (isResponsible(current, key)) {
                 break;
             }
             
@@ -442,6 +1504,26 @@ public:
                 finger = finger->next;
             }
             
+            // Bidirectional: a counter-clockwise finger that lands closer to
+            // the key from above wins; the owner is still succ(key)
+            if (bidirectional && nextHop != nullptr) {
+                long long remaining = ringDistance(nextHop->key, key);
+                long long behind = ringDistance(key, current->key);
+                for (finger = current->CCW.head; finger != nullptr; finger = finger->next) {
+                    if (finger->m == nullptr) continue;
+                    long long over = ringDistance(key, finger->machinekey);
+                    if (over < behind && over < remaining) {
+                        nextHop = finger->m;
+                        remaining = over;
+                    }
+                }
+            }
+            
+            // A learned shortcut to the owner, or closer than the fingers got
+            if (nextHop != nullptr && current->shortcuts.isEnabled()) {
+                nextHop = bestShortcut(current, key, nextHop);
+            }
+            
             // If no better hop found, go to immediate successor
             if (nextHop == nullptr) {
                 nextHop = current->next;
@@ -457,9 +1539,90 @@ public:
             visited.insert(current->key);
         }
         
+        if (origin->shortcuts.isEnabled() && current != origin) origin->shortcuts.record(current->key);
         return path;
     }
 
+    /**
+     * @brief Up to alpha routes from start to the owner of key, each leaving
+     *        through a different finger (the alpha closest to the key first)
+     * @details Chord fingers only; other routing modes return the one route
+     */
+    vector<vector<int>> routeAlternatives(int startMachineId, int key, int alpha) {
+        vector<vector<int>> routes;
+        CircularNode* start = findMachineById(startMachineId);
+        if (start == nullptr) return routes;
+        if (routing != RoutingMode::Chord || placement.isEnabled() || isResponsible(start, key) || alpha <= 1) {
+            routes.push_back(routeToKey(startMachineId, key));
+            return routes;
+        }
+
+        // First hops: fingers that do not pass the key, closest to it first
+        vector<CircularNode*> firstHops;
+        for (DoublyNode<CircularNode>* finger = start->RT.head; finger != nullptr; finger = finger->next) {
+            if (finger->m != nullptr && isBetween(finger->machinekey, start->key, key)) firstHops.push_back(finger->m);
+        }
+        reverse(firstHops.begin(), firstHops.end());
+        if (firstHops.empty()) firstHops.push_back(start->next);
+
+        for (size_t i = 0; i < firstHops.size() && routes.size() < static_cast<size_t>(alpha); i++) {
+            vector<int> route = { start->key };
+            for (int id : routeToKey(firstHops[i]->key, key)) route.push_back(id);
+            routes.push_back(route);
+        }
+        return routes;
+    }
+
+    /**
+     * @brief nextHop, or a shortcut of current that owns the key or lands
+     *        closer to it; links to machines that left are dropped
+     */
+    CircularNode* bestShortcut(CircularNode* current, int key, CircularNode* nextHop) {
+        long long remaining = min(ringDistance(nextHop->key, key), ringDistance(key, nextHop->key));
+        CircularNode* above = nullptr;      // Closest link at or after the key: the only possible owner
+        vector<int> stale;
+        for (const ShortcutCache::Entry& link : current->shortcuts.entries) {
+            CircularNode* node = findMachineById(link.machine);
+            if (node == nullptr) {
+                stale.push_back(link.machine);
+            } else if (isBetween(link.machine, current->key, key)) {
+                if (ringDistance(link.machine, key) < remaining) {
+                    nextHop = node;
+                    remaining = ringDistance(link.machine, key);
+                }
+            } else if (above == nullptr || ringDistance(key, link.machine) < ringDistance(key, above->key)) {
+                above = node;
+            }
+        }
+        for (int id : stale) current->shortcuts.forget(id);
+        if (above != nullptr && above != current && isResponsible(above, key)) return above;
+        return nextHop;
+    }
+
+    /**
+     * @brief Check if a machine is responsible for a key: pred < key <= machine
+     */
+    bool isResponsible(CircularNode* machine, int key) {
+        if (placement.isEnabled()) {
+            return placement.ownerOf(key) == machine->key;
+        }
+        if (ownerTable.isEnabled()) {
+            return ownerTable.lookup(key) == machine;
+        }
+        
+        CircularNode* pred = findPredecessor(machine->key);
+        int predKey = pred ? pred->key : -1;
+        
+        if (pred == machine) {
+            return true;  // Only one machine
+        } else if (predKey < machine->key) {
+            return (key > predKey && key <= machine->key);
+        } else {
+            // Wrap around case
+            return (key > predKey || key <= machine->key);
+        }
+    }
+
     /**
      * @brief Check if target is between start and end (circular)
      */
@@ -471,12 +1634,33 @@ public:
         }
     }
 
+    /**
+     * @brief Clockwise distance from one ID to another
+     */
+    long long ringDistance(int from, int to) const {
+        return ((static_cast<long long>(to) - from) % identifierSpace + identifierSpace) % identifierSpace;
+    }
+
     /**
      * @brief Find predecessor of a machine
      */
     CircularNode* findPredecessor(int machineKey) {
         if (head == nullptr) return nullptr;
         
+        if (trie.isEnabled()) {
+            if (!trie.contains(static_cast<uint64_t>(machineKey))) return nullptr;
+            uint64_t id = trie.predecessor(static_cast<uint64_t>(machineKey));
+            if (id == SuccessorTrie::NONE) id = trie.maximum();  // Wrap around
+            return nodeIndex[static_cast<int>(id)];
+        }
+        
+        if (occupancy.isEnabled()) {
+            if (!occupancy.test(machineKey)) return nullptr;
+            int64_t id = occupancy.predecessor(machineKey);
+            if (id < 0) id = occupancy.predecessor(occupancy.universe);  // Wrap around
+            return nodeIndex[static_cast<int>(id)];
+        }
+        
         CircularNode* current = head;
         do {
             if (current->next->key == machineKey) {
@@ -511,6 +1695,14 @@ public:
     CircularNode* findResponsibleMachine(int key) {
         if (head == nullptr) return nullptr;
         
+        if (placement.isEnabled()) {
+            return findMachineById(placement.ownerOf(key));
+        }
+        
+        if (ownerTable.isEnabled()) {
+            return ownerTable.lookup(key);
+        }
+        
         CircularNode* current = head;
         do {
             CircularNode* pred = findPredecessor(current->key);
@@ -534,6 +1726,111 @@ public:
         return head;  // Default to head
     }
 
+    /**
+     * @brief Store a file at its owner without routing output (workloads, benchmarks)
+     * @return Machine now holding the file, or nullptr if the key exists or the ring is empty
+     */
+    CircularNode* putFile(const FileNode& file, int order, const string* data = nullptr) {
+        CircularNode* owner = head != nullptr ? ownerOf(file.key) : nullptr;
+        if (owner == nullptr || locateFile(owner, file.key) != nullptr) return nullptr;
+        owner = drainTarget(owner);
+        if (owner != nullptr) {
+            FileNode stored = file;
+            storeBlock(owner, stored, data);
+            owner->BTreeroot.insertHelper(stored, order);
+            if (replicas.isEnabled()) storeReplicas(file, order);
+            invalidateMiss(file.key);
+        }
+        return owner;
+    }
+
+    /**
+     * @brief Look up a file without routing output; counts the hit
+     */
+    FileNode* getFile(int fileKey) {
+        CircularNode* owner = head != nullptr ? ownerOf(fileKey) : nullptr;
+        CircularNode* holder = owner != nullptr ? locateFile(owner, fileKey) : nullptr;
+        FileNode* file = holder != nullptr ? holder->BTreeroot.findFile(fileKey) : nullptr;
+        if (file != nullptr) file->hits++;
+        return file;
+    }
+
+    /**
+     * @brief Look up a batch of concurrent requests without routing output
+     * @details With coalescing on, requests from one origin for the same key
+     *          share one route (single flight at the origin) and requests that
+     *          reach the same owner share one B-tree descent (single flight at
+     *          the owner). Every request still counts a hit. The whole batch
+     *          is in flight together; its flights land when it returns.
+     *          Keys in the origin's negative cache are answered without routing.
+     * @return File for each request (nullptr if missing), in request order
+     */
+    vector<FileNode*> searchFiles(const vector<LookupRequest>& batch, CoalesceStats* stats = nullptr) {
+        vector<FileNode*> results(batch.size(), nullptr);
+        if (head == nullptr) return results;
+        SingleFlight<long long, int> atOrigin;      // (origin, key) -> machine the route ended at
+        SingleFlight<int, FileNode*> atOwner;       // key -> file
+        long long routes = 0, descents = 0;
+        if (coalesceLookups) {
+            atOrigin.reserve(batch.size());
+            atOwner.reserve(batch.size());
+        }
+
+        long long cached = 0;
+        for (size_t i = 0; i < batch.size(); i++) {
+            const LookupRequest& request = batch[i];
+            CircularNode* origin = findMachineById(request.origin);
+            if (origin != nullptr && cachedMiss(origin, request.key)) {
+                cached++;
+                continue;
+            }
+            auto route = [&]() -> int {
+                routes++;
+                vector<int> path = routeToKey(request.origin, request.key);
+                return path.empty() ? -1 : path.back();
+            };
+            long long flight = (static_cast<long long>(request.origin) << 32) | static_cast<uint32_t>(request.key);
+            int reached = coalesceLookups ? atOrigin.run(flight, route) : route();
+            if (reached < 0) continue;
+
+            auto descend = [&]() -> FileNode* {
+                descents++;
+                CircularNode* owner = findMachineById(reached);
+                CircularNode* holder = owner != nullptr ? locateFile(owner, request.key) : nullptr;
+                return holder != nullptr ? holder->BTreeroot.findFile(request.key) : nullptr;
+            };
+            FileNode* file = coalesceLookups ? atOwner.run(request.key, descend) : descend();
+            if (file != nullptr) {
+                file->hits++;
+            } else if (origin != nullptr) {
+                rememberMiss(origin, request.key);
+            }
+            results[i] = file;
+        }
+
+        if (stats != nullptr) {
+            stats->requests += static_cast<long long>(batch.size());
+            stats->routes += routes;
+            stats->descents += descents;
+            stats->cachedMisses += cached;
+        }
+        return results;
+    }
+
+    /**
+     * @brief Delete a file without routing output
+     */
+    bool removeFile(int fileKey) {
+        CircularNode* owner = head != nullptr ? ownerOf(fileKey) : nullptr;
+        CircularNode* holder = owner != nullptr ? locateFile(owner, fileKey) : nullptr;
+        if (holder == nullptr) return false;
+        releaseBlock(holder, fileKey);
+        holder->BTreeroot.deleteHelper(fileKey);
+        compactBlocks(holder);
+        if (replicas.isEnabled()) dropReplicas(fileKey);
+        return true;
+    }
+
     /**
      * @brief Insert file from a specific machine (shows routing path)
      */
@@ -578,16 +1875,33 @@ public:
         }
         
         // Check if file already exists
-        if (responsible->BTreeroot.searchFile(fileKey)) {
+        CircularNode* holder = locateFile(responsible, fileKey);
+        if (holder != nullptr) {
             cout << "\n  WARNING: File with key " << fileKey << " already exists on Machine " 
-                 << responsible->key << "!\n";
+                 << holder->key << "!\n";
             return;
         }
+
+        // Writes for a draining machine go to the machine taking over its range
+        if (responsible->draining) {
+            CircularNode* target = drainTarget(responsible);
+            cout << "\n  Machine " << responsible->key << " is draining; write redirected to Machine "
+                 << target->key << "\n";
+            responsible = target;
+        }
         
         // Insert into B-tree
+        storeBlock(responsible, file, nullptr);
         responsible->BTreeroot.insertHelper(file, order);
+        invalidateMiss(fileKey);
         
         cout << "\n  SUCCESS: File stored on Machine " << responsible->key << "\n";
+        if (replicas.isEnabled()) {
+            storeReplicas(file, order);
+            cout << "  Replicas (" << replicas.name() << "):";
+            for (CircularNode* machine : replicaSet(fileKey)) cout << " Machine " << machine->key;
+            cout << "\n";
+        }
         cout << "\n  B-Tree of Machine " << responsible->key << " after insertion:\n";
         responsible->BTreeroot.displayBFT(responsible->BTreeroot.root);
         cout << "  ============================================================\n";
@@ -607,6 +1921,14 @@ public:
         cout << "  ============================================================\n";
         cout << "  File Hash Key: " << fileKey << "\n";
         cout << "  Starting from Machine: " << machineKey << "\n";
+
+        CircularNode* origin = findMachineById(machineKey);
+        if (origin != nullptr && cachedMiss(origin, fileKey)) {
+            cout << "\n  NOT FOUND: File with key " << fileKey << " does not exist "
+                 << "(cached miss at Machine " << machineKey << ", not routed).\n";
+            cout << "  ============================================================\n";
+            return nullptr;
+        }
         
         vector<int> routingPath = routeToKey(machineKey, fileKey);
         printRoutingPath(routingPath, fileKey);
@@ -618,19 +1940,24 @@ public:
         
         int responsibleId = routingPath.back();
         CircularNode* responsible = findMachineById(responsibleId);
+        if (responsible != nullptr) {
+            responsible = locateFile(responsible, fileKey);  // May have drained onwards
+        }
         
-        if (responsible != nullptr && responsible->BTreeroot.searchFile(fileKey)) {
+        if (responsible != nullptr) {
             cout << "\n  FOUND: File with key " << fileKey << " exists on Machine " 
                  << responsible->key << "\n";
             
             FileNode* file = responsible->BTreeroot.findFile(fileKey);
             if (file) {
+                file->hits++;
                 cout << "  File Path: " << file->path << "\n";
             }
             cout << "  ============================================================\n";
             return responsible;
         }
         
+        if (origin != nullptr) rememberMiss(origin, fileKey);
         cout << "\n  NOT FOUND: File with key " << fileKey << " does not exist.\n";
         cout << "  ============================================================\n";
         return nullptr;
@@ -668,7 +1995,8 @@ public:
         }
         
         // Get file info before deletion
-        FileNode* file = responsible->BTreeroot.findFile(fileKey);
+        responsible = locateFile(responsible, fileKey);
+        FileNode* file = responsible ? responsible->BTreeroot.findFile(fileKey) : nullptr;
         if (file == nullptr) {
             cout << "\n  NOT FOUND: File with key " << fileKey << " does not exist.\n";
             cout << "  ============================================================\n";
@@ -678,7 +2006,10 @@ public:
         string filePath = file->path;
         
         // Delete from B-tree
+        releaseBlock(responsible, fileKey);
         responsible->BTreeroot.deleteHelper(fileKey);
+        compactBlocks(responsible);
+        if (replicas.isEnabled()) dropReplicas(fileKey);
         
         cout << "\n  DELETED: File with key " << fileKey << "\n";
         cout << "  Removed from Machine: " << responsible->key << "\n";
@@ -694,15 +2025,8 @@ public:
      * @brief Find machine by ID
      */
     CircularNode* findMachineById(int id) {
-        if (head == nullptr) return nullptr;
-        
-        CircularNode* current = head;
-        do {
-            if (current->key == id) return current;
-            current = current->next;
-        } while (current != head);
-        
-        return nullptr;
+        auto it = nodeIndex.find(id);
+        return it != nodeIndex.end() ? it->second : nullptr;
     }
 
     CircularNode* SearchNewMachine(int machineKey) {
@@ -723,6 +2047,14 @@ public:
      * @brief Print routing table for a machine with proper formatting
      */
     void printRT(int machineKey) {
+        if (routing == RoutingMode::Pastry) {
+            pastry.print(machineKey);
+            return;
+        }
+        if (routing == RoutingMode::Koorde) {
+            koorde.print(machineKey);
+            return;
+        }
         CircularNode* machine = findMachineById(machineKey);
         
         if (machine == nullptr) {
@@ -738,14 +2070,31 @@ public:
         cout << "  |  Entry |    Formula          | Target ID | Successor Machine          |\n";
         cout << "  +------------------------------------------------------------------------+\n";
         
-        DoublyNode<CircularNode>* finger = machine->RT.head;
-        int i = 0;
-        while (finger != nullptr && i < bits) {
-            cout << "  |  FT[" << setw(2) << left << (i + 1) << "] | succ(" << setw(3) << machineKey 
-                 << " + 2^" << setw(2) << left << i << ") | succ(" << setw(3) << left << finger->filekey 
-                 << ") | Machine " << setw(5) << left << finger->machinekey << "              |\n";
-            finger = finger->next;
-            i++;
+        // Clockwise fingers, then counter-clockwise ones (bidirectional routing)
+        for (int pass = 0; pass < (bidirectional ? 2 : 1); pass++) {
+            DoublyNode<CircularNode>* finger = pass == 0 ? machine->RT.head : machine->CCW.head;
+            const char* label = pass == 0 ? "FT" : "CC";
+            const char* fn = pass == 0 ? "succ(" : "pred(";
+            int i = 0, level = 0, j = 1;
+            while (finger != nullptr) {
+                // Same order as DoublyLinkedList::initialize(): j = 1..k-1 per level i
+                string term = fingerBase == 2 ? "2^" + to_string(level)
+                                              : to_string(j) + "*" + to_string(fingerBase) + "^" + to_string(level);
+                string index = to_string(i + 1);
+                if (finger->span > 1) index += "-" + to_string(i + finger->span);   // Merged run
+                cout << "  |  " << label << "[" << setw(2) << left << index << "] | " << fn << setw(3) << machineKey
+                     << (pass == 0 ? " + " : " - ") << setw(fingerBase == 2 ? 4 : 8) << left << term << ") | " << fn
+                     << setw(3) << left << finger->filekey << ") | Machine " << setw(5) << left << finger->machinekey
+                     << "              |\n";
+                for (int step = 0; step < finger->span; step++) {
+                    i++;
+                    if (++j == fingerBase) {
+                        j = 1;
+                        level++;
+                    }
+                }
+                finger = finger->next;
+            }
         }
         
         cout << "  +========================================================================+\n";
@@ -771,7 +2120,10 @@ public:
         cout << "  |                    B-TREE - Machine " << setw(5) << left << machineKey << "                           |\n";
         cout << "  +------------------------------------------------------------------------+\n";
         
-        if (getMachineCount() == 1) {
+        if (placement.isEnabled()) {
+            cout << "  |  Responsible for: keys hashed here by " << setw(10) << left << placement.name()
+                 << "                       |\n";
+        } else if (getMachineCount() == 1) {
             cout << "  |  Responsible for: ALL IDs (0 to " << setw(5) << left << (identifierSpace - 1) << ")                          |\n";
         } else if (rangeStart <= rangeEnd) {
             cout << "  |  Responsible for IDs: [" << setw(3) << rangeStart << ", " << setw(3) << rangeEnd << "]                                   |\n";
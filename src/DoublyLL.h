@@ -2,7 +2,10 @@
  * @file DoublyLL.h
  * @brief Doubly Linked List for Routing Table (Finger Table) implementation
  * @details Each machine has a routing table stored as a doubly linked list
- *          with log2(identifierSpace) entries
+ *          with log2(identifierSpace) entries, or (k-1)*log_k(identifierSpace)
+ *          entries for a base-k finger layout. Once resolved, consecutive
+ *          fingers with the same successor are merged into one entry covering
+ *          their targets, so a sparse ring stores O(log N) entries, not O(bits)
  * 
  * Compile: g++ -std=c++17 -Wall -o ipfs_dht src/*.cpp
  */
@@ -22,9 +25,10 @@ class CircularNode;
 template<typename Node>
 class DoublyNode {
 public:
-    int filekey;      // Target ID: (machine_id + 2^i) mod identifier_space
+    int filekey;      // Target ID: (machine_id + j*k^i) mod identifier_space
     int machinekey;   // Successor machine's ID
     Node* m;          // Pointer to successor machine
+    int span;         // Consecutive finger targets merged into this entry
 
     DoublyNode* prev;
     DoublyNode* next;
@@ -33,6 +37,7 @@ public:
         filekey = -1;
         machinekey = -1;
         m = nullptr;
+        span = 1;
         prev = nullptr;
         next = nullptr;
     }
@@ -41,6 +46,7 @@ public:
         filekey = f;
         machinekey = mk;
         m = nullptr;
+        span = 1;
         prev = nullptr;
         next = nullptr;
     }
@@ -92,31 +98,66 @@ public:
      * @brief Initialize routing table with finger table entries
      * @param machine_key ID of the machine
      * @param identifierSpace Total identifier space (2^bits)
+     * @param base Finger base k: entries at machine_key + j*k^i, 1 <= j < k
+     * @param counterClockwise Targets at machine_key - j*k^i instead
      */
-    void initialize(int machine_key, int identifierSpace) {
+    void initialize(int machine_key, int identifierSpace, int base = 2, bool counterClockwise = false) {
         m_val = machine_key;
+        if (base < 2) base = 2;
         
-        // Number of entries = log2(identifierSpace)
-        int numEntries = static_cast<int>(log2(identifierSpace));
-        if (numEntries < 1) numEntries = 1;
-        
-        for (int i = 0; i < numEntries; i++) {
-            // FT[i] = (machine_key + 2^i) mod identifierSpace
-            long long temp = machine_key + (1LL << i);
-            temp = temp % identifierSpace;
-            
-            DoublyNode<Node>* newNode = new DoublyNode<Node>(static_cast<int>(temp), -1);
-            
-            if (head == nullptr) {
-                head = tail = newNode;
+        // Entries in increasing distance; base 2 gives log2(identifierSpace)
+        for (long long step = 1; step < identifierSpace; step *= base) {
+            for (int j = 1; j < base && j * step < identifierSpace; j++) {
+                // FT = (machine_key + j*k^i) mod identifierSpace
+                long long temp = counterClockwise ? machine_key - j * step : machine_key + j * step;
+                temp = (temp % identifierSpace + identifierSpace) % identifierSpace;
+                append(static_cast<int>(temp));
+            }
+        }
+        if (head == nullptr) append(machine_key);
+    }
+
+    /**
+     * @brief Merge runs of entries resolving to the same machine; the first
+     *        entry of a run keeps its target and covers the rest
+     */
+    void mergeRuns() {
+        DoublyNode<Node>* current = head;
+        while (current != nullptr && current->next != nullptr) {
+            DoublyNode<Node>* next = current->next;
+            if (next->machinekey != current->machinekey) {
+                current = next;
+                continue;
+            }
+            current->span += next->span;
+            current->next = next->next;
+            if (next->next != nullptr) {
+                next->next->prev = current;
             } else {
-                tail->next = newNode;
-                newNode->prev = tail;
-                tail = newNode;
+                tail = current;
             }
+            delete next;
         }
     }
 
+    /**
+     * @brief Finger targets covered, counting merged ones
+     */
+    int targets() const {
+        int count = 0;
+        for (DoublyNode<Node>* current = head; current != nullptr; current = current->next) count += current->span;
+        return count;
+    }
+
+    /**
+     * @brief Number of stored finger entries
+     */
+    int size() const {
+        int count = 0;
+        for (DoublyNode<Node>* current = head; current != nullptr; current = current->next) count++;
+        return count;
+    }
+
     DoublyNode<Node>* getHead() {
         return head;
     }
@@ -147,6 +188,17 @@ public:
         }
     }
 
+    void append(int filekey) {
+        DoublyNode<Node>* newNode = new DoublyNode<Node>(filekey, -1);
+        if (head == nullptr) {
+            head = tail = newNode;
+        } else {
+            tail->next = newNode;
+            newNode->prev = tail;
+            tail = newNode;
+        }
+    }
+
     void setHead(DoublyNode<Node>* h) {
         head = h;
     }
@@ -0,0 +1,243 @@
+/**
+ * @file HostRegistry.h
+ * @brief Physical hosts with capacity weights, placed as virtual ring positions
+ * @details A host of weight w owns w * vnodesPerWeight ring positions
+ *          (ordinary CircularNodes at SHA-1 of "name#i"), so its share of the
+ *          key space, files and requests grows with its weight. Position i of
+ *          a host never changes, so changing a weight only adds or removes the
+ *          highest-numbered positions.
+ *
+ * Compile: g++ -std=c++17 -Wall -o ipfs_dht src/main.cpp
+ */
+
+#pragma once
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "CircularLL.h"
+#include "SHA1.h"
+using namespace std;
+
+/**
+ * @brief Registry of weighted hosts and the ring positions they own
+ */
+class HostRegistry {
+public:
+    static constexpr int DEFAULT_VNODES_PER_WEIGHT = 16;
+    static constexpr int MAX_WEIGHT = 64;
+
+    struct Host {
+        string name;
+        int weight;
+        vector<int> positions;      // positions[i] = ring ID of "name#i"
+    };
+
+    /**
+     * @brief Files, lookup hits and key space owned by one host
+     */
+    struct HostLoad {
+        long long files = 0;
+        long long hits = 0;
+        long long arc = 0;
+    };
+
+    vector<Host> hosts;
+    unordered_map<int, int> hostOfPosition;     // Ring ID -> index in hosts
+    int vnodesPerWeight;
+
+    HostRegistry() : vnodesPerWeight(DEFAULT_VNODES_PER_WEIGHT) {}
+
+    bool isEmpty() const { return hosts.empty(); }
+
+    int findHost(const string& name) const {
+        for (size_t i = 0; i < hosts.size(); i++) {
+            if (hosts[i].name == name) return static_cast<int>(i);
+        }
+        return -1;
+    }
+
+    /**
+     * @brief Host owning a ring position, or nullptr for a standalone machine
+     */
+    const Host* hostOf(int machineId) const {
+        auto it = hostOfPosition.find(machineId);
+        return it == hostOfPosition.end() ? nullptr : &hosts[it->second];
+    }
+
+    /**
+     * @brief Join a new host with weight * vnodesPerWeight positions
+     */
+    bool addHost(CircularLinkedList& ring, const string& name, int weight, int order) {
+        if (findHost(name) >= 0) {
+            cout << "\n  ERROR: Host \"" << name << "\" already exists!\n";
+            return false;
+        }
+        if (weight < 1 || weight > MAX_WEIGHT) {
+            cout << "\n  ERROR: Weight must be in range [1, " << MAX_WEIGHT << "]\n";
+            return false;
+        }
+        hosts.push_back({ name, 0, {} });
+        resize(ring, static_cast<int>(hosts.size()) - 1, weight, order);
+        return true;
+    }
+
+    /**
+     * @brief Change a host's weight; only the highest positions join or leave
+     * @details Weight 0 removes the host, like removeHost().
+     */
+    bool setWeight(CircularLinkedList& ring, const string& name, int weight, int order) {
+        int index = findHost(name);
+        if (index < 0) {
+            cout << "\n  ERROR: Host \"" << name << "\" not found!\n";
+            return false;
+        }
+        if (weight == 0) return removeHost(ring, name, order);
+        if (weight < 1 || weight > MAX_WEIGHT) {
+            cout << "\n  ERROR: Weight must be in range [1, " << MAX_WEIGHT << "] (0 removes the host)\n";
+            return false;
+        }
+        resize(ring, index, weight, order);
+        return true;
+    }
+
+    /**
+     * @brief Remove a host and all of its positions
+     */
+    bool removeHost(CircularLinkedList& ring, const string& name, int order) {
+        int index = findHost(name);
+        if (index < 0) {
+            cout << "\n  ERROR: Host \"" << name << "\" not found!\n";
+            return false;
+        }
+        resize(ring, index, 0, order);
+        hosts.erase(hosts.begin() + index);
+        hostOfPosition.clear();
+        for (size_t i = 0; i < hosts.size(); i++) {
+            for (int id : hosts[i].positions) hostOfPosition[id] = static_cast<int>(i);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Per-host load; the last entry collects standalone machines
+     */
+    vector<HostLoad> measure(CircularLinkedList& ring) const {
+        vector<HostLoad> loads(hosts.size() + 1);
+        if (ring.head == nullptr) return loads;
+
+        CircularNode* pred = ring.head;
+        while (pred->next != ring.head) pred = pred->next;
+        CircularNode* current = ring.head;
+        do {
+            auto it = hostOfPosition.find(current->key);
+            HostLoad& load = loads[it == hostOfPosition.end() ? hosts.size() : static_cast<size_t>(it->second)];
+            load.arc += ring.arcLength(pred, current);
+            if (current->BTreeroot.root != nullptr) {
+                for (const FileNode& file : current->BTreeroot.getAllFiles(current->BTreeroot.root)) {
+                    load.files++;
+                    load.hits += file.hits;
+                }
+            }
+            pred = current;
+            current = current->next;
+        } while (current != ring.head);
+        return loads;
+    }
+
+    /**
+     * @brief Print each host's share of weight, key space, files and requests
+     * @details "Files/W" is the host's file share divided by its weight
+     *          share; 1.00 means the host stores exactly its fair part.
+     */
+    void printReport(CircularLinkedList& ring) const {
+        vector<HostLoad> loads = measure(ring);
+        long long totalWeight = 0, totalFiles = 0, totalHits = 0;
+        for (const Host& host : hosts) totalWeight += host.weight;
+        for (const HostLoad& load : loads) {
+            totalFiles += load.files;
+            totalHits += load.hits;
+        }
+
+        auto pct = [](long long part, long long total) {
+            return total > 0 ? 100.0 * static_cast<double>(part) / static_cast<double>(total) : 0.0;
+        };
+
+        cout << "\n  +========================================================================+\n";
+        cout << "  |                     HOST CAPACITY REPORT                               |\n";
+        cout << "  +------------------------------------------------------------------------+\n";
+        cout << "  |  Host         | Wt | Pos  | Weight% | Keys%  | Files% | Req%   | Files/W |\n";
+        cout << "  +------------------------------------------------------------------------+\n";
+        cout << fixed << setprecision(1);
+        for (size_t i = 0; i <= hosts.size(); i++) {
+            const HostLoad& load = loads[i];
+            if (i == hosts.size() && load.arc == 0) break;     // No standalone machines
+            bool standalone = (i == hosts.size());
+            string name = standalone ? "(standalone)" : hosts[i].name.substr(0, 12);
+            int weight = standalone ? 0 : hosts[i].weight;
+            size_t positions = standalone ? 0 : hosts[i].positions.size();
+            double weightShare = pct(weight, totalWeight);
+            double fileShare = pct(load.files, totalFiles);
+
+            cout << "  |  " << setw(12) << left << name << " | " << setw(2) << right << weight
+                 << " | " << setw(4) << positions << " | " << setw(6) << weightShare << "% | "
+                 << setw(5) << pct(load.arc, ring.identifierSpace) << "% | " << setw(5) << fileShare
+                 << "% | " << setw(5) << pct(load.hits, totalHits) << "% | ";
+            if (weightShare > 0) {
+                cout << setw(7) << setprecision(2) << fileShare / weightShare << setprecision(1) << " |\n";
+            } else {
+                cout << "      - |\n";
+            }
+        }
+        cout << defaultfloat << setprecision(6) << left;
+        cout << "  +========================================================================+\n";
+    }
+
+private:
+    /**
+     * @brief Hash a label into the identifier space, probing past taken IDs
+     */
+    int freePosition(CircularLinkedList& ring, const string& label) const {
+        int space = ring.identifierSpace;
+        int id = generateHashInSpace(label, space);
+        for (int probe = 0; probe < space; probe++) {
+            int candidate = (id + probe) % space;
+            if (!ring.search(candidate) && hostOfPosition.count(candidate) == 0) return candidate;
+        }
+        return -1;
+    }
+
+    /**
+     * @brief Grow or shrink a host to weight * vnodesPerWeight positions in one batch
+     */
+    void resize(CircularLinkedList& ring, int index, int weight, int order) {
+        Host& host = hosts[static_cast<size_t>(index)];
+        size_t target = static_cast<size_t>(weight) * static_cast<size_t>(vnodesPerWeight);
+
+        vector<int> joins;
+        vector<int> leaves;
+        while (host.positions.size() > target) {
+            leaves.push_back(host.positions.back());
+            hostOfPosition.erase(host.positions.back());
+            host.positions.pop_back();
+        }
+        while (host.positions.size() < target) {
+            int id = freePosition(ring, host.name + "#" + to_string(host.positions.size()));
+            if (id < 0) {
+                cout << "\n  WARNING: Identifier space is full, host \"" << host.name << "\" got "
+                     << host.positions.size() << " position(s).\n";
+                break;
+            }
+            host.positions.push_back(id);
+            hostOfPosition[id] = index;
+            joins.push_back(id);
+        }
+        host.weight = weight;
+
+        bool wasVerbose = ring.verbose;
+        ring.verbose = false;
+        ring.applyMembershipBatch(joins, leaves, order);
+        ring.verbose = wasVerbose;
+    }
+};
@@ -8,6 +8,8 @@
 
 #pragma once
 #include "CircularLL.h"
+#include "HostRegistry.h"
+#include <chrono>
 #include <vector>
 #include <string>
 
@@ -16,10 +18,14 @@
  */
 class IPFS {
 public:
+    static constexpr int DRAIN_CHUNK = 8;   // Files moved per draining machine per pump
+
     CircularLinkedList* C;      // Circular linked list of machines
     int identifierSpace;        // 2^bits
     int bits;                   // Number of bits
     int order;                  // B-tree order
+    chrono::steady_clock::time_point lastRebalance;  // Last rebalancer pump
+    HostRegistry hosts;         // Weighted physical hosts (virtual positions)
 
     IPFS() : C(nullptr), identifierSpace(16), bits(4), order(5) {}
 
@@ -50,6 +56,31 @@ public:
     int getMaxId() const { return identifierSpace - 1; }
     int getMachineCount() const { return C ? C->getMachineCount() : 0; }
 
+    /**
+     * @brief Precompute owner[id] so placement is a single array read
+     * @return false if bits exceeds OwnerTable::MAX_BITS
+     */
+    bool EnableDirectMapping() {
+        return C->enableDirectMapping();
+    }
+
+    bool isDirectMapped() const { return C && C->isDirectMapped(); }
+
+    /**
+     * @brief Serve succ/pred from a rank/select bitmap of machine IDs
+     * @details Costs 2^bits / 8 bytes; on by default up to OccupancyBitmap::AUTO_BITS
+     */
+    bool EnableOccupancyBitmap() {
+        return C->enableOccupancyBitmap();
+    }
+
+    /**
+     * @brief Serve succ/pred from a vEB-style trie (memory O(N), not O(2^bits))
+     */
+    void EnableSuccessorTrie() {
+        C->enableSuccessorTrie();
+    }
+
     /**
      * @brief Validate machine ID
      */
@@ -57,18 +88,41 @@ public:
         return id >= 0 && id < identifierSpace;
     }
 
+    /**
+     * @brief Print an error if a host owns this ring position
+     * @details Removing a host's position directly would leave the registry
+     *          pointing at a machine that no longer exists.
+     */
+    bool rejectHostPosition(int id) const {
+        const HostRegistry::Host* host = hosts.hostOf(id);
+        if (host == nullptr) return false;
+        cout << "\n  ERROR: Machine " << id << " is a position of host \"" << host->name
+             << "\". Use SetHostWeight or RemoveHost instead!\n";
+        return true;
+    }
+
     /**
      * @brief Insert multiple machines (initial setup)
      */
     void InsertMachines(int* arr, int num_mac) {
+        vector<int> added;
         for (int i = 0; i < num_mac; i++) {
             if (isValidMachineId(arr[i])) {
                 C->insert(arr[i]);
+                added.push_back(arr[i]);
             } else {
                 cout << "  WARNING: Machine ID " << arr[i] << " is out of range and was skipped.\n";
             }
         }
         C->updateRT();
+        if (C->placement.isEnabled()) {
+            C->placement.update(added, {});
+            C->rehomeFiles(order);
+        }
+        if (C->replicas.isEnabled()) {
+            C->replicas.update(added, {});
+            C->refreshReplicas(order);
+        }
         cout << "\n  " << C->getMachineCount() << " machine(s) added successfully!\n";
     }
 
@@ -84,12 +138,207 @@ public:
     }
 
     /**
-     * @brief Remove a machine dynamically
+     * @brief Suggest a join ID that splits the most loaded arc
+     */
+    JoinProposal ProposeJoinId(LoadMetric metric) {
+        return C->proposeJoinId(metric);
+    }
+
+    /**
+     * @brief Add a physical host whose ring share scales with its weight
+     */
+    bool AddHost(const string& name, int weight) {
+        return hosts.addHost(*C, name, weight, order);
+    }
+
+    bool SetHostWeight(const string& name, int weight) {
+        return hosts.setWeight(*C, name, weight, order);
+    }
+
+    bool RemoveHost(const string& name) {
+        return hosts.removeHost(*C, name, order);
+    }
+
+    void PrintHostReport() {
+        hosts.printReport(*C);
+    }
+
+    /**
+     * @brief Remove a machine dynamically; host positions go through SetHostWeight / RemoveHost
      */
     void DeleteMachine(int machineKey, int btreeOrder) {
+        if (rejectHostPosition(machineKey)) return;
         C->deletekey(machineKey, btreeOrder);
     }
 
+    /**
+     * @brief Remove a machine gracefully: it keeps serving while PumpDrains()
+     *        moves its files, and is unlinked once empty
+     */
+    bool DrainMachine(int machineKey) {
+        if (rejectHostPosition(machineKey)) return false;
+        return C->beginDrain(machineKey);
+    }
+
+    bool isDraining() const { return C && C->isDraining(); }
+
+    /**
+     * @brief Advance background draining by one chunk per draining machine
+     */
+    int PumpDrains(int chunkFiles = DRAIN_CHUNK) {
+        return C->pumpDrains(chunkFiles, order);
+    }
+
+    /**
+     * @brief Move join handoffs to a throttled background rebalancer
+     * @param filesPerSecond Transfer budget (<= 0 = unlimited)
+     * @param bytesPerSecond Byte budget for files with a known size (<= 0 = unlimited)
+     */
+    void EnableRebalancer(double filesPerSecond, double bytesPerSecond = 0) {
+        C->enableRebalancer(bytesPerSecond, filesPerSecond);
+        lastRebalance = chrono::steady_clock::now();
+    }
+
+    bool isRebalancing() const { return C && !C->rebalancer.isIdle(); }
+
+    /**
+     * @brief Give the rebalancer the wall-clock time since the last call
+     */
+    int PumpRebalancer() {
+        chrono::steady_clock::time_point now = chrono::steady_clock::now();
+        double seconds = chrono::duration<double>(now - lastRebalance).count();
+        lastRebalance = now;
+        return C->rebalanceStep(seconds, order);
+    }
+
+    /**
+     * @brief Apply several joins and leaves with one handoff pass
+     * @details Leaves that are host positions are skipped (see rejectHostPosition).
+     * @return Number of files moved
+     */
+    int ApplyMembershipBatch(const vector<int>& joins, const vector<int>& leaves) {
+        vector<int> standalone;
+        for (int id : leaves) {
+            const HostRegistry::Host* host = hosts.hostOf(id);
+            if (host != nullptr) {
+                cout << "  WARNING: Machine " << id << " is a position of host \"" << host->name
+                     << "\" and was skipped.\n";
+            } else {
+                standalone.push_back(id);
+            }
+        }
+        return C->applyMembershipBatch(joins, standalone, order);
+    }
+
+    /**
+     * @brief Silence per-machine progress output (scripted / bulk runs)
+     */
+    void SetVerbose(bool enabled) { C->verbose = enabled; }
+
+    /**
+     * @brief Map keys to machines by ring successor, jump hash or Maglev table
+     */
+    bool SetPlacement(PlacementMode mode) {
+        return C->setPlacement(mode, order);
+    }
+
+    PlacementMode getPlacement() const { return C ? C->placement.mode : PlacementMode::Ring; }
+
+    /**
+     * @brief Chord fingers at n + j*k^i: fewer hops for more entries per machine
+     */
+    void SetFingerBase(int base) {
+        C->setFingerBase(base);
+    }
+
+    /**
+     * @brief Keep counter-clockwise fingers too and route in either direction
+     */
+    void SetBidirectional(bool enabled) {
+        C->setBidirectional(enabled);
+    }
+
+    /**
+     * @brief Learn up to slots shortcut links per machine from its own lookups
+     */
+    void SetShortcuts(int slots) {
+        C->setShortcuts(slots);
+    }
+
+    /**
+     * @brief Route with Chord finger tables, Pastry prefix tables (base 2^digitBits)
+     *        or Koorde de Bruijn pointers (degree 2^digitBits)
+     */
+    void SetRouting(RoutingMode mode, int digitBits = PastryRouter::DEFAULT_DIGIT_BITS) {
+        C->setRouting(mode, digitBits);
+    }
+
+    /**
+     * @brief Keep factor copies of every file (primary + replicas)
+     * @param mode SuccessorList, Rendezvous (flat HRW) or Skeleton (O(log N) HRW)
+     */
+    int EnableReplication(ReplicaMode mode, int factor) {
+        return C->enableReplication(mode, factor, order);
+    }
+
+    /**
+     * @brief Quiet put/get/delete for workloads: no routing output
+     */
+    bool Put(int fileKey, const string& path, long long size = 0) {
+        return C->putFile(FileNode(fileKey, path, size), order) != nullptr;
+    }
+
+    FileNode* Get(int fileKey) {
+        return C->getFile(fileKey);
+    }
+
+    /**
+     * @brief Quiet put of a file with its contents (stored when the block store is on)
+     */
+    bool PutData(int fileKey, const string& path, const string& data) {
+        return C->putFile(FileNode(fileKey, path, static_cast<long long>(data.size())), order, &data) != nullptr;
+    }
+
+    /**
+     * @brief Read a file's contents from its holder's block log
+     */
+    bool ReadData(int fileKey, string& data) {
+        return C->readFile(fileKey, data);
+    }
+
+    bool Delete(int fileKey) {
+        return C->removeFile(fileKey);
+    }
+
+    /**
+     * @brief Quiet lookups for a batch of concurrent requests (see SetCoalescing)
+     */
+    vector<FileNode*> SearchFiles(const vector<LookupRequest>& batch, CoalesceStats* stats = nullptr) {
+        return C->searchFiles(batch, stats);
+    }
+
+    /**
+     * @brief Store file bytes in an append-only block log per machine under dir
+     * @return Files already stored that were written to the logs, or -1 on error
+     */
+    int EnableBlockStore(const string& dir, long long segmentBytes = BlockLog::DEFAULT_SEGMENT_BYTES) {
+        return C->enableBlockStore(dir, segmentBytes);
+    }
+
+    /**
+     * @brief Cache up to slots recent misses per origin machine (0 = off)
+     */
+    void SetNegativeCache(int slots) {
+        C->setNegativeCache(slots);
+    }
+
+    /**
+     * @brief Let identical in-flight lookups share one route and one B-tree descent
+     */
+    void SetCoalescing(bool enabled) {
+        C->coalesceLookups = enabled;
+    }
+
     /**
      * @brief Insert file from specified machine
      */
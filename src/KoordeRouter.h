@@ -0,0 +1,205 @@
+/**
+ * @file KoordeRouter.h
+ * @brief Koorde constant-degree routing over a de Bruijn graph of the ring
+ * @details Machine m with successor s keeps k = 2^c de Bruijn pointers,
+ *          pred(k*m + j*(s - m)) for j < k, which split [k*m, k*s) evenly.
+ *          A lookup carries an imaginary de Bruijn node i that the current
+ *          machine stands in for (i in [m, s)). Each hop shifts the next c bits
+ *          of the key into i and jumps to the pointer just before k*i, and
+ *          successor steps finish the way to pred(i). After about log_k N
+ *          shifts i equals the key and the current machine's successor owns
+ *          it. The start i already holds as many key bits as fit in the first
+ *          machine's arc, which keeps the hop count at O(log N) rather than
+ *          O(bits). Routing state is k + 1 entries whatever the size of the
+ *          identifier space.
+ *
+ * Compile: g++ -std=c++17 -Wall -o ipfs_dht src/main.cpp
+ */
+
+#pragma once
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+using namespace std;
+
+/**
+ * @brief de Bruijn pointers for all machines and the Koorde lookup
+ */
+class KoordeRouter {
+public:
+    static constexpr int DEFAULT_DIGIT_BITS = 1;
+    static constexpr int MAX_DIGIT_BITS = 4;
+
+    int digitBits;          // c: bits shifted per de Bruijn hop, degree k = 2^c
+    int degree;             // k: de Bruijn pointers per machine
+    int keyBits;            // Width of the identifier space
+    vector<int> ids;        // Machine IDs, sorted
+    vector<int> debruijn;   // debruijn[i * k + j] = index of pred(k*m + j*(s - m))
+
+    KoordeRouter() : digitBits(0), degree(0), keyBits(0) {}
+
+    bool isEnabled() const { return digitBits > 0; }
+
+    /**
+     * @brief Turn Koorde routing on with degree 2^c over a keyBits-wide space
+     */
+    void enable(int c, int identifierBits) {
+        digitBits = max(1, min(c, MAX_DIGIT_BITS));
+        degree = 1 << digitBits;
+        keyBits = identifierBits;
+    }
+
+    void disable() {
+        digitBits = 0;
+        ids.clear();
+        debruijn.clear();
+    }
+
+    /**
+     * @brief Recompute every de Bruijn pointer for the given sorted machine IDs
+     */
+    void rebuild(const vector<int>& sortedIds) {
+        ids = sortedIds;
+        size_t k = static_cast<size_t>(degree);
+        debruijn.resize(ids.size() * k);
+        for (size_t i = 0; i < ids.size(); i++) {
+            long long base = (static_cast<long long>(ids[i]) << digitBits) & mask();
+            for (size_t j = 0; j < k; j++) {
+                long long target = (base + static_cast<long long>(j) * arcWidth(i)) & mask();
+                debruijn[i * k + j] = static_cast<int>(predIndex(target));
+            }
+        }
+    }
+
+    /**
+     * @brief Machine IDs visited from start to succ(key), start included
+     */
+    vector<int> route(int startId, int key) const {
+        vector<int> path;
+        size_t n = ids.size();
+        if (n == 0) return path;
+        size_t cur = static_cast<size_t>(lower_bound(ids.begin(), ids.end(), startId) - ids.begin()) % n;
+        size_t owner = static_cast<size_t>(lower_bound(ids.begin(), ids.end(), key) - ids.begin()) % n;
+        path.push_back(ids[cur]);
+
+        long long k = key;
+        int remaining = 0;              // Key bits not yet shifted into i
+        long long i = imaginaryStart(cur, k, remaining);
+        size_t guard = 2 * n + 2;
+        while (cur != owner && guard-- > 0) {
+            size_t next = (cur + 1) % n;
+            if (next == owner) {
+                cur = next;             // Key lies in (cur, succ]
+            } else if (i < 0) {
+                cur = next;             // Arc too short to start from; try the successor's
+                i = imaginaryStart(cur, k, remaining);
+            } else if (remaining > 0 && manages(cur, i)) {
+                // Shift the next digit of the key into i and follow the de Bruijn edge
+                remaining -= digitBits;
+                i = ((i << digitBits) | ((k >> remaining) & (degree - 1))) & mask();
+                cur = deBruijnHop(cur, i);
+            } else {
+                cur = next;             // pred(i) is further along the ring
+            }
+            path.push_back(ids[cur]);
+        }
+        return path;
+    }
+
+    /**
+     * @brief Routing state of one machine: successor plus de Bruijn pointers
+     */
+    int stateEntries() const {
+        return 1 + degree;
+    }
+
+    size_t memoryBytes() const {
+        return (ids.capacity() + debruijn.capacity()) * sizeof(int);
+    }
+
+    /**
+     * @brief Print the successor and de Bruijn pointers of one machine
+     */
+    void print(int machineId) const {
+        size_t n = ids.size();
+        size_t i = static_cast<size_t>(lower_bound(ids.begin(), ids.end(), machineId) - ids.begin());
+        if (i >= n || ids[i] != machineId) {
+            cout << "\n  ERROR: Machine " << machineId << " not found!\n";
+            return;
+        }
+        cout << "\n  +========================================================================+\n";
+        cout << "  |        KOORDE ROUTING STATE - Machine " << setw(10) << left << machineId
+             << " (degree " << setw(2) << degree << ")           |\n";
+        cout << "  +------------------------------------------------------------------------+\n";
+        cout << "  |  Successor:     " << ids[(i + 1) % n] << "\n";
+        cout << "  |  de Bruijn:    ";
+        for (size_t j = 0; j < static_cast<size_t>(degree); j++) {
+            cout << " " << ids[static_cast<size_t>(debruijn[i * static_cast<size_t>(degree) + j])];
+        }
+        cout << "\n  +========================================================================+\n";
+    }
+
+private:
+    long long mask() const { return (1LL << keyBits) - 1; }
+
+    /**
+     * @brief Index of the last machine at or before x (wrapping)
+     */
+    size_t predIndex(long long x) const {
+        size_t n = ids.size();
+        size_t pos = static_cast<size_t>(upper_bound(ids.begin(), ids.end(), x) - ids.begin());
+        return (pos + n - 1) % n;
+    }
+
+    /**
+     * @brief Ring distance from ids[cur] to its successor (whole ring if alone)
+     */
+    long long arcWidth(size_t cur) const {
+        long long space = mask() + 1;
+        long long width = (ids[(cur + 1) % ids.size()] - ids[cur] + space) % space;
+        return width == 0 ? space : width;
+    }
+
+    /**
+     * @brief True when x is in [ids[cur], ids[cur + 1]) on the ring
+     */
+    bool manages(size_t cur, long long x) const {
+        long long space = mask() + 1;
+        return (x - ids[cur] + space) % space < arcWidth(cur);
+    }
+
+    /**
+     * @brief Imaginary node to start from: the machine's own ID with as many
+     *        low bits replaced by the key's top bits as stays inside its arc
+     * @return -1 if no choice fits (arc shorter than 2^(keyBits mod c))
+     */
+    long long imaginaryStart(size_t cur, long long k, int& remaining) const {
+        long long m = ids[cur];
+        for (int rest = 0; rest <= keyBits; rest += digitBits) {
+            int t = keyBits - rest;     // Key bits placed now; rest is a whole number of shifts
+            long long top = t > 0 ? k >> rest : 0;
+            for (long long up = 0; up <= 1; up++) {
+                long long base = t < keyBits ? (m >> t) + up : up;
+                long long candidate = ((base << t) | top) & mask();
+                if (manages(cur, candidate)) {
+                    remaining = rest;
+                    return candidate;
+                }
+            }
+        }
+        return -1;
+    }
+
+    /**
+     * @brief De Bruijn pointer at or just before the shifted imaginary node i,
+     *        which lies in [k*m, k*s); successor steps cover the rest
+     */
+    size_t deBruijnHop(size_t cur, long long i) const {
+        long long space = mask() + 1;
+        long long base = (static_cast<long long>(ids[cur]) << digitBits) & mask();
+        long long j = ((i - base + space) % space) / arcWidth(cur);
+        j = min(j, static_cast<long long>(degree - 1));
+        return static_cast<size_t>(debruijn[cur * static_cast<size_t>(degree) + static_cast<size_t>(j)]);
+    }
+};
@@ -0,0 +1,188 @@
+/**
+ * @file LatencySimulator.h
+ * @brief Message latency model and lookup strategies for tail latency
+ * @details Every message costs propagation between the two machines (each
+ *          machine sits at a fixed point of a unit square; the far corner is
+ *          `spanUs` away) plus the receiver's processing time: a base latency
+ *          times log-normal jitter. A small share of machines is persistently
+ *          slow and any message can hit a rare spike, which is what makes one
+ *          bad hop dominate a whole lookup. A route is charged in one of two
+ *          styles:
+ *          - Recursive: each hop forwards to the next; the owner answers the
+ *            origin directly (hops + 1 messages).
+ *          - Iterative: the origin asks each hop in turn and gets a referral
+ *            (or the answer) back (2 x hops messages).
+ *          Lookups are simulated under three strategies:
+ *          - Single: one greedy route.
+ *          - Parallel: alpha routes leaving through different fingers at
+ *            once; the first answer wins and every message is counted.
+ *          - Hedged: one route; if it has not answered after hedgeAfterUs, a
+ *            second request goes to a replica holder (or, without
+ *            replication, to the owner along a different first finger).
+ *
+ * Compile: g++ -std=c++17 -Wall -o ipfs_dht src/main.cpp
+ */
+
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "CircularLL.h"
+using namespace std;
+
+/**
+ * @brief How the hops of a route are contacted
+ */
+enum class LookupStyle {
+    Recursive,  // Each hop forwards; the owner replies to the origin
+    Iterative   // The origin contacts every hop and gets a referral back
+};
+
+/**
+ * @brief Per-message latency: propagation + base(machine) x jitter, with slow machines and spikes
+ */
+class LatencyModel {
+public:
+    static constexpr double DEFAULT_MEDIAN_US = 500.0;
+    static constexpr double JITTER_SIGMA = 0.25;        // Log-normal spread of ordinary messages
+    static constexpr double SLOW_MACHINE_SHARE = 0.02;  // Machines that are always slow
+    static constexpr double SLOW_FACTOR = 8.0;
+    static constexpr double SPIKE_CHANCE = 0.005;       // Any message: GC pause, queueing burst
+    static constexpr double SPIKE_FACTOR = 40.0;
+
+    double medianUs;        // Median processing time per message
+    double spanUs;          // Propagation across the whole square (0 = co-located)
+
+    explicit LatencyModel(uint64_t seed = 1, double median = DEFAULT_MEDIAN_US, double span = 0)
+        : medianUs(median), spanUs(span), rng(seed), jitter(0.0, JITTER_SIGMA), uniform(0.0, 1.0) {}
+
+    /**
+     * @brief True for the fixed share of machines that are always slow
+     */
+    static bool isSlow(int machine) {
+        uint64_t h = PlacementEngine::mix(static_cast<uint64_t>(machine) ^ 0xA5A5A5A5ULL);
+        return static_cast<double>(h >> 11) / static_cast<double>(1ULL << 53) < SLOW_MACHINE_SHARE;
+    }
+
+    /**
+     * @brief One-way propagation between two machines, in microseconds
+     */
+    double propagation(int from, int to) const {
+        if (spanUs <= 0 || from == to) return 0;
+        double dx = coordinate(from, 0) - coordinate(to, 0);
+        double dy = coordinate(from, 1) - coordinate(to, 1);
+        return spanUs * sqrt(dx * dx + dy * dy) / sqrt(2.0);
+    }
+
+    /**
+     * @brief Latency of one message from one machine to another, in microseconds
+     */
+    double message(int from, int to) {
+        double us = medianUs * exp(jitter(rng));
+        if (isSlow(to)) us *= SLOW_FACTOR;
+        if (uniform(rng) < SPIKE_CHANCE) us *= SPIKE_FACTOR;
+        return propagation(from, to) + us;
+    }
+
+    /**
+     * @brief Latency of a route (path[0] is the origin) in the given style
+     */
+    double route(const vector<int>& path, LookupStyle style = LookupStyle::Recursive) {
+        if (path.size() < 2) return 0;
+        double us = 0;
+        int origin = path[0];
+        for (size_t i = 1; i < path.size(); i++) {
+            if (style == LookupStyle::Iterative) {
+                us += message(origin, path[i]) + message(path[i], origin);   // Request + referral
+            } else {
+                us += message(path[i - 1], path[i]);                          // Forward
+            }
+        }
+        if (style == LookupStyle::Recursive) us += message(path.back(), origin);  // Answer
+        return us;
+    }
+
+    /**
+     * @brief Messages a route costs in the given style
+     */
+    static int messages(const vector<int>& path, LookupStyle style) {
+        if (path.size() < 2) return 0;
+        int hops = static_cast<int>(path.size()) - 1;
+        return style == LookupStyle::Iterative ? 2 * hops : hops + 1;
+    }
+
+private:
+    mt19937_64 rng;
+    normal_distribution<double> jitter;
+    uniform_real_distribution<double> uniform;
+
+    static double coordinate(int machine, int axis) {
+        uint64_t h = PlacementEngine::mix(static_cast<uint64_t>(machine) * 2 + static_cast<uint64_t>(axis));
+        return static_cast<double>(h >> 11) / static_cast<double>(1ULL << 53);
+    }
+};
+
+/**
+ * @brief How a lookup is issued
+ */
+enum class LookupMode {
+    Single,     // One greedy route
+    Parallel,   // Alpha routes through different first fingers, first answer wins
+    Hedged      // Second request to a replica once the first is late
+};
+
+/**
+ * @brief Latency and message count of one simulated lookup
+ */
+struct LookupCost {
+    double latencyUs;
+    int messages;
+};
+
+/**
+ * @brief Simulated lookups over a ring's real routes
+ */
+class LookupSimulator {
+public:
+    CircularLinkedList* ring;
+    LatencyModel& latency;
+    LookupStyle style;
+
+    LookupSimulator(CircularLinkedList* r, LatencyModel& model, LookupStyle lookupStyle = LookupStyle::Recursive)
+        : ring(r), latency(model), style(lookupStyle) {}
+
+    /**
+     * @param alpha Parallel routes (Parallel)
+     * @param hedgeAfterUs Delay before the hedged request (Hedged), e.g. the p95 of Single
+     */
+    LookupCost lookup(int startId, int key, LookupMode mode, int alpha = 2, double hedgeAfterUs = 0) {
+        if (mode == LookupMode::Parallel) {
+            LookupCost cost = { -1, 0 };
+            for (const vector<int>& route : ring->routeAlternatives(startId, key, alpha)) {
+                double us = latency.route(route, style);
+                if (cost.latencyUs < 0 || us < cost.latencyUs) cost.latencyUs = us;
+                cost.messages += LatencyModel::messages(route, style);
+            }
+            if (cost.latencyUs < 0) cost.latencyUs = 0;
+            return cost;
+        }
+
+        vector<int> primary = ring->routeToKey(startId, key);
+        LookupCost cost = { latency.route(primary, style), LatencyModel::messages(primary, style) };
+        if (mode != LookupMode::Hedged || cost.latencyUs <= hedgeAfterUs) return cost;
+
+        // Late: ask a replica holder, or the owner again along another first finger
+        vector<int> backup;
+        vector<CircularNode*> holders = ring->replicaSet(key);
+        if (!holders.empty()) {
+            backup = ring->routeToKey(startId, holders[0]->key);
+        } else {
+            vector<vector<int>> routes = ring->routeAlternatives(startId, key, 2);
+            backup = routes.size() > 1 ? routes[1] : primary;
+        }
+        cost.latencyUs = min(cost.latencyUs, hedgeAfterUs + latency.route(backup, style));
+        cost.messages += LatencyModel::messages(backup, style);
+        return cost;
+    }
+};
@@ -0,0 +1,430 @@
+/**
+ * @file LockFreeSkipList.h
+ * @brief Lock-free skip list for concurrent ring membership
+ * @details Ordered set of machine IDs that many threads can join, leave and
+ *          query at the same time without locks (Fraser / Herlihy-Shavit
+ *          design: logical deletion by marking the low bit of next pointers,
+ *          physical unlinking by CAS during traversal). ConcurrentRing adds
+ *          the wrap-around succ/pred semantics of CircularLinkedList.
+ *
+ *          Removed nodes are retired, not freed, because a concurrent reader
+ *          may still hold them. A node is retired only once it is unlinked
+ *          on every level; if it is erased while its inserter is still
+ *          linking index levels, the inserter unlinks and retires it. Call
+ *          reclaimRetired() only when no other thread is using the list
+ *          (e.g. between simulation phases).
+ *
+ * Compile: g++ -std=c++17 -Wall -pthread -o ipfs_dht src/main.cpp
+ */
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <limits>
+using namespace std;
+
+/**
+ * @brief Lock-free ordered map from 64-bit key to Value
+ * @tparam Value Payload stored with each key; read concurrently, so it
+ *         should be cheap to copy (an ID or pointer)
+ */
+template<typename Value>
+class LockFreeSkipList {
+public:
+    static constexpr int MAX_LEVEL = 24;    // Enough for ~16M keys at p = 1/2
+
+    // Node::state: who unlinks and retires a node erased while its index levels are linked
+    static constexpr int LINKING = 0;       // Inserter still linking index levels
+    static constexpr int LINKED = 1;        // Insert finished; the eraser retires
+    static constexpr int ERASED = 2;        // Erased during LINKING; the inserter retires
+
+    struct Node {
+        int64_t key;
+        Value value;
+        int topLevel;
+        Node* retiredNext;                  // Link in the retired list
+        atomic<int> state;
+        atomic<uintptr_t> next[MAX_LEVEL + 1];  // Low bit = logically deleted
+
+        Node(int64_t k, const Value& v, int top)
+            : key(k), value(v), topLevel(top), retiredNext(nullptr), state(LINKING) {
+            for (int i = 0; i <= MAX_LEVEL; i++) {
+                next[i].store(0, memory_order_relaxed);
+            }
+        }
+    };
+
+    Node* head;                 // Sentinel, key = INT64_MIN
+    Node* tail;                 // Sentinel, key = INT64_MAX
+    atomic<long long> count;
+    atomic<int> levelHint;      // Highest level ever used; traversals start here
+    atomic<Node*> retired;      // Treiber stack of removed nodes
+
+    LockFreeSkipList() : count(0), levelHint(0), retired(nullptr) {
+        head = new Node(numeric_limits<int64_t>::min(), Value(), MAX_LEVEL);
+        tail = new Node(numeric_limits<int64_t>::max(), Value(), MAX_LEVEL);
+        for (int i = 0; i <= MAX_LEVEL; i++) {
+            head->next[i].store(pack(tail, false), memory_order_relaxed);
+        }
+    }
+
+    ~LockFreeSkipList() {
+        Node* current = head;
+        while (current != nullptr) {
+            Node* next = (current == tail) ? nullptr : ptrOf(current->next[0].load());
+            delete current;
+            current = next;
+        }
+        reclaimRetired();
+    }
+
+    LockFreeSkipList(const LockFreeSkipList&) = delete;
+    LockFreeSkipList& operator=(const LockFreeSkipList&) = delete;
+
+    size_t size() const {
+        long long n = count.load(memory_order_relaxed);
+        return n < 0 ? 0 : static_cast<size_t>(n);
+    }
+
+    bool isEmpty() const { return first() == nullptr; }
+
+    /**
+     * @brief Add key; false if already present
+     */
+    bool insert(int64_t key, const Value& value) {
+        int top = randomLevel();
+        int hint = levelHint.load(memory_order_relaxed);
+        while (top > hint && !levelHint.compare_exchange_weak(hint, top, memory_order_relaxed)) {
+        }
+        Node* preds[MAX_LEVEL + 1];
+        Node* succs[MAX_LEVEL + 1];
+
+        while (true) {
+            if (find(key, preds, succs)) return false;
+
+            Node* node = new Node(key, value, top);
+            for (int l = 0; l <= top; l++) {
+                node->next[l].store(pack(succs[l], false), memory_order_relaxed);
+            }
+
+            // Linearization point: link at the bottom level
+            uintptr_t expected = pack(succs[0], false);
+            if (!preds[0]->next[0].compare_exchange_strong(expected, pack(node, false),
+                                                            memory_order_acq_rel)) {
+                delete node;    // Never visible to other threads
+                continue;
+            }
+            count.fetch_add(1, memory_order_relaxed);
+            linkIndexLevels(node, preds, succs);
+
+            // An erase that finished while we were linking left the unlink to us
+            int state = LINKING;
+            if (!node->state.compare_exchange_strong(state, LINKED, memory_order_acq_rel)) {
+                unlinkAndRetire(node, preds, succs);
+            }
+            return true;
+        }
+    }
+
+    /**
+     * @brief Remove key; false if absent or removed by another thread first
+     */
+    bool erase(int64_t key) {
+        Node* preds[MAX_LEVEL + 1];
+        Node* succs[MAX_LEVEL + 1];
+        if (!find(key, preds, succs)) return false;
+
+        Node* node = succs[0];
+        for (int l = node->topLevel; l >= 1; l--) {
+            uintptr_t word = node->next[l].load(memory_order_acquire);
+            while (!isMarked(word)) {
+                node->next[l].compare_exchange_weak(word, word | 1, memory_order_acq_rel);
+            }
+        }
+
+        // Linearization point: whoever marks the bottom level owns the removal
+        uintptr_t word = node->next[0].load(memory_order_acquire);
+        while (true) {
+            if (isMarked(word)) return false;
+            if (node->next[0].compare_exchange_strong(word, word | 1, memory_order_acq_rel)) {
+                count.fetch_sub(1, memory_order_relaxed);
+
+                // The inserter may still be linking index levels; if so it unlinks and retires
+                int state = LINKING;
+                if (!node->state.compare_exchange_strong(state, ERASED, memory_order_acq_rel)) {
+                    unlinkAndRetire(node, preds, succs);
+                }
+                return true;
+            }
+        }
+    }
+
+    bool contains(int64_t key) const {
+        Node* node = ceilingNode(key);
+        return node != nullptr && node->key == key;
+    }
+
+    /**
+     * @brief First live node with key >= x, or nullptr (wait-free)
+     */
+    Node* ceilingNode(int64_t x) const {
+        Node* pred = head;
+        Node* curr = nullptr;
+        for (int level = levelHint.load(memory_order_acquire); level >= 0; level--) {
+            curr = ptrOf(pred->next[level].load(memory_order_acquire));
+            while (true) {
+                uintptr_t succWord = curr->next[level].load(memory_order_acquire);
+                while (isMarked(succWord)) {    // Skip logically deleted nodes
+                    curr = ptrOf(succWord);
+                    succWord = curr->next[level].load(memory_order_acquire);
+                }
+                if (curr->key < x) {
+                    pred = curr;
+                    curr = ptrOf(succWord);
+                } else {
+                    break;
+                }
+            }
+        }
+        return curr == tail ? nullptr : curr;
+    }
+
+    /**
+     * @brief Last live node with key < x, or nullptr (wait-free)
+     */
+    Node* lowerNode(int64_t x) const {
+        Node* pred = head;
+        for (int level = levelHint.load(memory_order_acquire); level >= 0; level--) {
+            Node* curr = ptrOf(pred->next[level].load(memory_order_acquire));
+            while (true) {
+                uintptr_t succWord = curr->next[level].load(memory_order_acquire);
+                while (isMarked(succWord)) {
+                    curr = ptrOf(succWord);
+                    succWord = curr->next[level].load(memory_order_acquire);
+                }
+                if (curr->key < x) {
+                    pred = curr;
+                    curr = ptrOf(succWord);
+                } else {
+                    break;
+                }
+            }
+        }
+        return pred == head ? nullptr : pred;
+    }
+
+    Node* first() const { return ceilingNode(numeric_limits<int64_t>::min() + 1); }
+
+    Node* last() const { return lowerNode(numeric_limits<int64_t>::max()); }
+
+    /**
+     * @brief Visit live nodes in ascending key order
+     */
+    template<typename Visitor>
+    void forEach(Visitor visit) const {
+        Node* curr = ptrOf(head->next[0].load(memory_order_acquire));
+        while (curr != tail) {
+            uintptr_t succWord = curr->next[0].load(memory_order_acquire);
+            if (!isMarked(succWord)) visit(curr->key, curr->value);
+            curr = ptrOf(succWord);
+        }
+    }
+
+    /**
+     * @brief Free removed nodes; caller guarantees no concurrent access
+     */
+    void reclaimRetired() {
+        Node* node = retired.exchange(nullptr);
+        while (node != nullptr) {
+            Node* next = node->retiredNext;
+            delete node;
+            node = next;
+        }
+    }
+
+    /**
+     * @brief Approximate heap footprint (live nodes only)
+     */
+    size_t memoryBytes() const {
+        return (size() + 2) * sizeof(Node);
+    }
+
+private:
+    static Node* ptrOf(uintptr_t word) {
+        return reinterpret_cast<Node*>(word & ~static_cast<uintptr_t>(1));
+    }
+
+    static bool isMarked(uintptr_t word) {
+        return (word & 1) != 0;
+    }
+
+    static uintptr_t pack(Node* node, bool marked) {
+        return reinterpret_cast<uintptr_t>(node) | (marked ? 1 : 0);
+    }
+
+    /**
+     * @brief Geometric level with p = 1/2 from a per-thread xorshift
+     */
+    static int randomLevel() {
+        static atomic<uint64_t> seeds(0x9E3779B97F4A7C15ULL);
+        thread_local uint64_t state = seeds.fetch_add(0x9E3779B97F4A7C15ULL) | 1;
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        uint64_t bits = state;
+        int level = 0;
+        while ((bits & 1) && level < MAX_LEVEL) {
+            level++;
+            bits >>= 1;
+        }
+        return level;
+    }
+
+    /**
+     * @brief Locate preds/succs of key on every level, unlinking marked nodes
+     * @return true if an unmarked node with this key exists
+     */
+    bool find(int64_t key, Node** preds, Node** succs) {
+    retry:
+        Node* pred = head;
+        for (int level = levelHint.load(memory_order_acquire); level >= 0; level--) {
+            Node* curr = ptrOf(pred->next[level].load(memory_order_acquire));
+            while (true) {
+                uintptr_t succWord = curr->next[level].load(memory_order_acquire);
+                while (isMarked(succWord)) {
+                    uintptr_t expected = pack(curr, false);
+                    if (!pred->next[level].compare_exchange_strong(expected, pack(ptrOf(succWord), false),
+                                                                    memory_order_acq_rel)) {
+                        goto retry;     // pred changed or was marked itself
+                    }
+                    curr = ptrOf(succWord);
+                    succWord = curr->next[level].load(memory_order_acquire);
+                }
+                if (curr->key < key) {
+                    pred = curr;
+                    curr = ptrOf(succWord);
+                } else {
+                    break;
+                }
+            }
+            preds[level] = pred;
+            succs[level] = curr;
+        }
+        return succs[0]->key == key;
+    }
+
+    /**
+     * @brief Link node above level 0; stops early if the node is removed meanwhile
+     */
+    void linkIndexLevels(Node* node, Node** preds, Node** succs) {
+        for (int l = 1; l <= node->topLevel; l++) {
+            while (true) {
+                uintptr_t own = node->next[l].load(memory_order_acquire);
+                if (isMarked(own)) return;
+                if (ptrOf(own) != succs[l] &&
+                    !node->next[l].compare_exchange_strong(own, pack(succs[l], false),
+                                                           memory_order_acq_rel)) {
+                    continue;
+                }
+                uintptr_t expected = pack(succs[l], false);
+                if (preds[l]->next[l].compare_exchange_strong(expected, pack(node, false),
+                                                               memory_order_acq_rel)) {
+                    break;
+                }
+                find(node->key, preds, succs);
+                if (succs[0] != node) return;
+            }
+        }
+    }
+
+    /**
+     * @brief True if node is still linked on some level after find() filled preds
+     * @details Nodes with the node's key follow preds[l], so only that run is scanned.
+     */
+    bool isLinked(Node* node, Node** preds) const {
+        for (int l = 0; l <= node->topLevel; l++) {
+            Node* curr = ptrOf(preds[l]->next[l].load(memory_order_acquire));
+            while (curr != tail && curr->key <= node->key) {
+                if (curr == node) return true;
+                curr = ptrOf(curr->next[l].load(memory_order_acquire));
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Unlink a marked node from every level, then retire it
+     * @details Called once per node, by whichever of the inserter and the
+     *          eraser finishes last, so no later CAS can link it again.
+     */
+    void unlinkAndRetire(Node* node, Node** preds, Node** succs) {
+        do {
+            find(node->key, preds, succs);
+        } while (isLinked(node, preds));
+        retire(node);
+    }
+
+    void retire(Node* node) {
+        Node* top = retired.load(memory_order_relaxed);
+        do {
+            node->retiredNext = top;
+        } while (!retired.compare_exchange_weak(top, node, memory_order_release,
+                                                memory_order_relaxed));
+    }
+};
+
+/**
+ * @brief Concurrent ring membership with CircularLinkedList semantics
+ * @details succ(x) is the first machine with ID >= x, wrapping to the
+ *          smallest ID; pred(x) is the last machine with ID < x, wrapping to
+ *          the largest. Traversal order matches the sorted ring.
+ * @tparam Value Payload per machine (e.g. an index or pointer)
+ */
+template<typename Value>
+class ConcurrentRing {
+public:
+    typedef typename LockFreeSkipList<Value>::Node Node;
+
+    LockFreeSkipList<Value> members;
+
+    bool join(int machineId, const Value& value = Value()) {
+        return members.insert(machineId, value);
+    }
+
+    bool leave(int machineId) {
+        return members.erase(machineId);
+    }
+
+    bool contains(int machineId) const {
+        return members.contains(machineId);
+    }
+
+    size_t size() const { return members.size(); }
+
+    /**
+     * @brief Machine responsible for key (first ID >= key, wrapping)
+     * @return nullptr only if the ring is empty
+     */
+    Node* succ(int key) const {
+        Node* node = members.ceilingNode(key);
+        return node != nullptr ? node : members.first();
+    }
+
+    /**
+     * @brief Machine preceding key (last ID < key, wrapping)
+     */
+    Node* pred(int key) const {
+        Node* node = members.lowerNode(key);
+        return node != nullptr ? node : members.last();
+    }
+
+    /**
+     * @brief Visit machines in ring order starting from the head (smallest ID)
+     */
+    template<typename Visitor>
+    void forEachMachine(Visitor visit) const {
+        members.forEach(visit);
+    }
+
+    void reclaimRetired() { members.reclaimRetired(); }
+};
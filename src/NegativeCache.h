@@ -0,0 +1,129 @@
+/**
+ * @file NegativeCache.h
+ * @brief Bounded per-machine cache of recent not-found answers
+ * @details An origin machine remembers keys its lookups found missing,
+ *          tagged with the ring's membership epoch at the time. A cached
+ *          miss answers a repeat lookup locally only while the epoch is
+ *          unchanged; any join, leave or placement change makes every entry
+ *          stale. Inserting the key invalidates it explicitly (the ring
+ *          tracks which origins cached the miss). When full, the oldest miss
+ *          is evicted first.
+ *
+ * Compile: g++ -std=c++17 -Wall -o ipfs_dht src/main.cpp
+ */
+
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+#include <utility>
+using namespace std;
+
+/**
+ * @brief Recent misses of one origin, oldest evicted first
+ */
+class NegativeCache {
+public:
+    static constexpr int DEFAULT_SLOTS = 256;
+    static constexpr int MAX_SLOTS = 65536;
+
+    long long hits;         // Lookups answered from the cache
+
+    NegativeCache() : hits(0), capacity(0), stamp(0) {}
+
+    bool isEnabled() const { return capacity > 0; }
+
+    size_t size() const { return entries.size(); }
+
+    /**
+     * @brief Keep at most slots misses (0 turns caching off and drops all)
+     */
+    void resize(int slots) {
+        capacity = slots < 0 ? 0 : (slots > MAX_SLOTS ? MAX_SLOTS : slots);
+        while (entries.size() > static_cast<size_t>(capacity)) evictOldest();
+        if (capacity == 0) clear();
+    }
+
+    /**
+     * @brief True if key is a cached miss from the current epoch (counts a hit)
+     */
+    bool contains(int key, long long epoch) {
+        auto it = entries.find(key);
+        if (it == entries.end()) return false;
+        if (it->second.epoch != epoch) {
+            entries.erase(it);      // Membership changed since
+            return false;
+        }
+        hits++;
+        return true;
+    }
+
+    /**
+     * @brief Remember that key was not found during epoch
+     * @return Key evicted to make room, or -1
+     */
+    int remember(int key, long long epoch) {
+        if (capacity == 0) return -1;
+        auto it = entries.find(key);
+        if (it != entries.end()) {
+            it->second.epoch = epoch;
+            return -1;
+        }
+        int evicted = entries.size() == static_cast<size_t>(capacity) ? evictOldest() : -1;
+        entries[key] = { epoch, ++stamp };
+        order.push_back({ key, stamp });
+        if (order.size() > 2 * static_cast<size_t>(capacity)) compact();
+        return evicted;
+    }
+
+    /**
+     * @brief Drop a cached miss (the key was inserted)
+     */
+    void forget(int key) {
+        entries.erase(key);
+    }
+
+    void clear() {
+        entries.clear();
+        order.clear();
+    }
+
+private:
+    /**
+     * @brief Membership epoch of a miss and its insertion stamp
+     */
+    struct Entry {
+        long long epoch;
+        uint64_t stamp;
+    };
+
+    int capacity;
+    uint64_t stamp;                         // Insertion counter
+    unordered_map<int, Entry> entries;      // Key -> miss
+    deque<pair<int, uint64_t>> order;       // (key, stamp) oldest first; stale pairs skipped
+
+    /**
+     * @brief Drop order pairs of misses already forgotten or replaced
+     */
+    void compact() {
+        deque<pair<int, uint64_t>> live;
+        for (const pair<int, uint64_t>& p : order) {
+            auto it = entries.find(p.first);
+            if (it != entries.end() && it->second.stamp == p.second) live.push_back(p);
+        }
+        order.swap(live);
+    }
+
+    int evictOldest() {
+        while (!order.empty()) {
+            pair<int, uint64_t> oldest = order.front();
+            order.pop_front();
+            auto it = entries.find(oldest.first);
+            if (it != entries.end() && it->second.stamp == oldest.second) {
+                entries.erase(it);
+                return oldest.first;
+            }
+        }
+        return -1;
+    }
+};
@@ -0,0 +1,286 @@
+/**
+ * @file OccupancyBitmap.h
+ * @brief Succinct bitmap of occupied machine IDs with rank/select support
+ * @details One bit per ID plus a rank directory with one counter per 512-bit
+ *          block, so successor/predecessor queries take a few word operations
+ *          regardless of how many machines are in the ring.
+ *
+ * Compile: g++ -std=c++17 -Wall -o ipfs_dht src/main.cpp
+ */
+
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+using namespace std;
+
+// ============================================================================
+// Word-level bit operations (popcnt / tzcnt / lzcnt)
+// ============================================================================
+
+inline int popcount64(uint64_t x) {
+#ifdef _MSC_VER
+    return static_cast<int>(__popcnt64(x));
+#else
+    return __builtin_popcountll(x);
+#endif
+}
+
+/**
+ * @brief Index of lowest set bit (x must be non-zero)
+ */
+inline int ctz64(uint64_t x) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, x);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(x);
+#endif
+}
+
+/**
+ * @brief Index of highest set bit (x must be non-zero)
+ */
+inline int msb64(uint64_t x) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanReverse64(&index, x);
+    return static_cast<int>(index);
+#else
+    return 63 - __builtin_clzll(x);
+#endif
+}
+
+/**
+ * @brief Position of the k-th set bit (0-based) inside a word
+ */
+inline int selectInWord(uint64_t x, int k) {
+    for (int i = 0; i < k; i++) {
+        x &= x - 1;  // Drop lowest set bit
+    }
+    return ctz64(x);
+}
+
+/**
+ * @brief Bitmap over [0, universe) with rank/select acceleration
+ * @details The rank directory is rebuilt lazily from the first modified block,
+ *          so a burst of joins/leaves costs one prefix-sum pass. A sampled
+ *          select index (block of every S-th set bit) narrows select() to a
+ *          short range; S adapts so the samples stay within ~1/64 of the bitmap.
+ */
+class OccupancyBitmap {
+public:
+    static constexpr int BLOCK_WORDS = 8;              // 512 bits = one cache line
+    static constexpr uint64_t MAX_UNIVERSE = 1ULL << 32;
+    static constexpr int AUTO_BITS = 24;               // 2 MB bitmap, enabled by default
+
+    vector<uint64_t> words;         // Bit i set <=> ID i occupied
+    vector<uint64_t> blockRank;     // blockRank[b] = set bits before block b
+    vector<uint32_t> selectBlock;   // selectBlock[j] = block of the (j * sampleRate)-th set bit
+    uint64_t sampleRate;            // Set bits per select sample (power of two)
+    uint64_t universe;              // Number of IDs covered
+    uint64_t ones;                  // Number of set bits
+    size_t dirtyBlock;              // First block whose rank is stale
+
+    OccupancyBitmap() : sampleRate(1), universe(0), ones(0), dirtyBlock(0) {}
+
+    bool isEnabled() const { return universe > 0; }
+
+    /**
+     * @brief Allocate an empty bitmap for IDs [0, universeSize)
+     * @return false if the universe is empty or larger than 2^32
+     */
+    bool init(uint64_t universeSize) {
+        if (universeSize == 0 || universeSize > MAX_UNIVERSE) return false;
+        universe = universeSize;
+        size_t numWords = static_cast<size_t>((universe + 63) / 64);
+        size_t numBlocks = (numWords + BLOCK_WORDS - 1) / BLOCK_WORDS;
+        words.assign(numBlocks * BLOCK_WORDS, 0);
+        blockRank.assign(numBlocks + 1, 0);
+        selectBlock.clear();
+        sampleRate = 1;
+        ones = 0;
+        dirtyBlock = numBlocks;
+        return true;
+    }
+
+    void release() {
+        vector<uint64_t>().swap(words);
+        vector<uint64_t>().swap(blockRank);
+        vector<uint32_t>().swap(selectBlock);
+        universe = 0;
+        ones = 0;
+        dirtyBlock = 0;
+    }
+
+    bool test(uint64_t x) const {
+        return (words[x >> 6] >> (x & 63)) & 1;
+    }
+
+    void set(uint64_t x) {
+        uint64_t bit = 1ULL << (x & 63);
+        if (words[x >> 6] & bit) return;
+        words[x >> 6] |= bit;
+        ones++;
+        markDirty(x);
+    }
+
+    void reset(uint64_t x) {
+        uint64_t bit = 1ULL << (x & 63);
+        if (!(words[x >> 6] & bit)) return;
+        words[x >> 6] &= ~bit;
+        ones--;
+        markDirty(x);
+    }
+
+    /**
+     * @brief Number of set bits in [0, x)
+     */
+    uint64_t rank(uint64_t x) {
+        refreshRank();
+        size_t w = static_cast<size_t>(x >> 6);
+        size_t block = w / BLOCK_WORDS;
+        uint64_t r = blockRank[block];
+        for (size_t i = block * BLOCK_WORDS; i < w; i++) {
+            r += popcount64(words[i]);
+        }
+        if (x & 63) {
+            r += popcount64(words[w] & ((1ULL << (x & 63)) - 1));
+        }
+        return r;
+    }
+
+    /**
+     * @brief Position of the k-th set bit (0-based), or -1 if k >= ones
+     */
+    int64_t select(uint64_t k) {
+        if (k >= ones) return -1;
+        refreshRank();
+
+        // Last block whose prefix count is <= k, between two select samples
+        size_t j = static_cast<size_t>(k / sampleRate);
+        size_t lo = selectBlock[j];
+        size_t hi = (j + 1 < selectBlock.size()) ? selectBlock[j + 1] + 1 : blockRank.size() - 1;
+        size_t step = 1;
+        while (lo + step < hi && blockRank[lo + step] <= k) {
+            step <<= 1;  // Gallop: the answer is usually within a few blocks of lo
+        }
+        size_t from = lo + step / 2;
+        size_t to = min(lo + step, hi);
+        size_t block = static_cast<size_t>(
+            upper_bound(blockRank.begin() + from, blockRank.begin() + to, k) - blockRank.begin()) - 1;
+        uint64_t remaining = k - blockRank[block];
+
+        size_t w = block * BLOCK_WORDS;
+        while (true) {
+            uint64_t c = popcount64(words[w]);
+            if (remaining < c) break;
+            remaining -= c;
+            w++;
+        }
+        return static_cast<int64_t>(w * 64 + selectInWord(words[w], static_cast<int>(remaining)));
+    }
+
+    /**
+     * @brief Smallest set position >= x, or -1 if none
+     */
+    int64_t successor(uint64_t x) {
+        if (x >= universe) return -1;
+        size_t w = static_cast<size_t>(x >> 6);
+        uint64_t word = words[w] & (~0ULL << (x & 63));
+        if (word) return static_cast<int64_t>(w * 64 + ctz64(word));
+
+        // Rest of the cache line, then jump with the rank directory
+        size_t blockEnd = (w / BLOCK_WORDS + 1) * BLOCK_WORDS;
+        for (size_t i = w + 1; i < blockEnd; i++) {
+            if (words[i]) return static_cast<int64_t>(i * 64 + ctz64(words[i]));
+        }
+        refreshRank();
+        return select(blockRank[blockEnd / BLOCK_WORDS]);
+    }
+
+    /**
+     * @brief Largest set position < x, or -1 if none
+     */
+    int64_t predecessor(uint64_t x) {
+        if (x > universe) x = universe;
+        if (x == 0) return -1;
+        uint64_t last = x - 1;
+        size_t w = static_cast<size_t>(last >> 6);
+        uint64_t mask = ((last & 63) == 63) ? ~0ULL : ((1ULL << ((last & 63) + 1)) - 1);
+        uint64_t word = words[w] & mask;
+        if (word) return static_cast<int64_t>(w * 64 + msb64(word));
+
+        size_t blockStart = (w / BLOCK_WORDS) * BLOCK_WORDS;
+        for (size_t i = w; i-- > blockStart;) {
+            if (words[i]) return static_cast<int64_t>(i * 64 + msb64(words[i]));
+        }
+        refreshRank();
+        uint64_t before = blockRank[blockStart / BLOCK_WORDS];
+        return before == 0 ? -1 : select(before - 1);
+    }
+
+    size_t memoryBytes() const {
+        return words.capacity() * sizeof(uint64_t) + blockRank.capacity() * sizeof(uint64_t)
+             + selectBlock.capacity() * sizeof(uint32_t);
+    }
+
+private:
+    void markDirty(uint64_t x) {
+        size_t block = static_cast<size_t>(x >> 6) / BLOCK_WORDS;
+        if (block < dirtyBlock) dirtyBlock = block;
+    }
+
+    /**
+     * @brief Recompute select samples affected by blocks >= dirtyBlock
+     */
+    void refreshSelect() {
+        // One 4-byte sample per sampleRate ones, capped at universe / 512 bytes
+        uint64_t budget = max<uint64_t>(1, universe / 2048);
+        uint64_t rate = 1;
+        while (ones / rate > budget) rate <<= 1;
+
+        size_t numBlocks = blockRank.size() - 1;
+        size_t firstBlock = dirtyBlock;
+        if (rate != sampleRate) {
+            sampleRate = rate;
+            firstBlock = 0;
+        }
+
+        // Samples for ones before firstBlock are unchanged
+        size_t j = static_cast<size_t>((blockRank[firstBlock] + sampleRate - 1) / sampleRate);
+        selectBlock.resize(static_cast<size_t>((ones + sampleRate - 1) / sampleRate));
+        for (size_t b = firstBlock; b < numBlocks && j < selectBlock.size(); b++) {
+            while (j < selectBlock.size() && j * sampleRate < blockRank[b + 1]) {
+                selectBlock[j++] = static_cast<uint32_t>(b);
+            }
+        }
+    }
+
+    /**
+     * @brief Recompute prefix counts from the first modified block onwards
+     * @details Counts 8 independent words per block so the loop vectorizes
+     *          (e.g. VPOPCNTQ) where the target supports it.
+     */
+    void refreshRank() {
+        size_t numBlocks = blockRank.size() - 1;
+        if (dirtyBlock >= numBlocks) return;
+
+        uint64_t r = blockRank[dirtyBlock];
+        for (size_t b = dirtyBlock; b < numBlocks; b++) {
+            const uint64_t* line = &words[b * BLOCK_WORDS];
+            uint64_t c = 0;
+            for (int i = 0; i < BLOCK_WORDS; i++) {
+                c += popcount64(line[i]);
+            }
+            r += c;
+            blockRank[b + 1] = r;
+        }
+        refreshSelect();
+        dirtyBlock = numBlocks;
+    }
+};
@@ -0,0 +1,139 @@
+/**
+ * @file OwnerTable.h
+ * @brief Direct-mapped responsibility table for small identifier spaces
+ * @details Stores a compact machine index for every ID in the identifier space,
+ *          so the machine responsible for a key is found with one array read.
+ *          Joins and leaves only rewrite the arc whose owner changes.
+ *
+ * Compile: g++ -std=c++17 -Wall -o ipfs_dht src/main.cpp
+ */
+
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+using namespace std;
+
+/**
+ * @brief owner[id] table mapping every ID to its responsible machine
+ * @tparam Node Type of machine node (CircularNode)
+ */
+template<class Node>
+class OwnerTable {
+public:
+    static constexpr int MAX_BITS = 22;              // 2^22 IDs = 16 MB of slots
+    static constexpr uint32_t NO_OWNER = 0xFFFFFFFFu;
+
+    vector<uint32_t> owner;       // owner[id] = slot of responsible machine
+    vector<Node*> slots;          // slot -> machine
+    vector<uint32_t> freeSlots;   // slots released by removed machines
+
+    bool isEnabled() const {
+        return !owner.empty();
+    }
+
+    /**
+     * @brief Allocate the table for the whole identifier space
+     * @return false if the identifier space is too large for a direct map
+     */
+    bool enable(int identifierSpace) {
+        if (identifierSpace <= 0 || identifierSpace > (1 << MAX_BITS)) return false;
+        owner.assign(identifierSpace, NO_OWNER);
+        slots.clear();
+        freeSlots.clear();
+        return true;
+    }
+
+    void disable() {
+        vector<uint32_t>().swap(owner);
+        vector<Node*>().swap(slots);
+        vector<uint32_t>().swap(freeSlots);
+    }
+
+    /**
+     * @brief Machine responsible for a key (single array read)
+     */
+    Node* lookup(int key) const {
+        uint32_t slot = owner[key];
+        return slot == NO_OWNER ? nullptr : slots[slot];
+    }
+
+    /**
+     * @brief Record a machine that was just linked after pred
+     * @param pred Predecessor in the ring (the machine itself if it is alone)
+     */
+    void onJoin(Node* machine, Node* pred) {
+        uint32_t slot = allocSlot(machine);
+        if (pred == machine) {
+            fill(owner.begin(), owner.end(), slot);
+        } else {
+            assignArc(pred->key, machine->key, slot);
+        }
+    }
+
+    /**
+     * @brief Hand the arc of a leaving machine to its successor
+     * @details Must be called while the machine is still linked
+     */
+    void onLeave(Node* machine, Node* pred, Node* succ) {
+        uint32_t slot = owner[machine->key];
+        if (succ == machine) {
+            fill(owner.begin(), owner.end(), NO_OWNER);
+        } else {
+            assignArc(pred->key, machine->key, owner[succ->key]);
+        }
+        slots[slot] = nullptr;
+        freeSlots.push_back(slot);
+    }
+
+    /**
+     * @brief Recompute the whole table from the ring
+     */
+    void rebuild(Node* head) {
+        fill(owner.begin(), owner.end(), NO_OWNER);
+        slots.clear();
+        freeSlots.clear();
+        if (head == nullptr) return;
+
+        Node* pred = head;
+        while (pred->next != head) pred = pred->next;
+
+        Node* current = head;
+        do {
+            onJoin(current, pred);
+            pred = current;
+            current = current->next;
+        } while (current != head);
+    }
+
+    size_t memoryBytes() const {
+        return owner.capacity() * sizeof(uint32_t) + slots.capacity() * sizeof(Node*)
+             + freeSlots.capacity() * sizeof(uint32_t);
+    }
+
+private:
+    uint32_t allocSlot(Node* machine) {
+        if (!freeSlots.empty()) {
+            uint32_t slot = freeSlots.back();
+            freeSlots.pop_back();
+            slots[slot] = machine;
+            return slot;
+        }
+        slots.push_back(machine);
+        return static_cast<uint32_t>(slots.size() - 1);
+    }
+
+    /**
+     * @brief Set owner of every ID in the circular range (from, to]
+     */
+    void assignArc(int from, int to, uint32_t slot) {
+        int size = static_cast<int>(owner.size());
+        int start = (from + 1) % size;
+        if (start <= to) {
+            fill(owner.begin() + start, owner.begin() + to + 1, slot);
+        } else {
+            fill(owner.begin() + start, owner.end(), slot);
+            fill(owner.begin(), owner.begin() + to + 1, slot);
+        }
+    }
+};
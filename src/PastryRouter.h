@@ -0,0 +1,207 @@
+/**
+ * @file PastryRouter.h
+ * @brief Pastry-style prefix routing with leaf sets over the ring IDs
+ * @details IDs are read as digits of b bits. Row r of a machine's routing
+ *          table holds, for every digit value d, some machine that shares the
+ *          first r digits with it and has d as digit r, so each hop fixes at
+ *          least one more digit of the key: about log_{2^b} N hops. The leaf
+ *          set (L/2 machines on each side) finishes the route to succ(key),
+ *          the machine responsible under ring placement.
+ *
+ * Compile: g++ -std=c++17 -Wall -o ipfs_dht src/main.cpp
+ */
+
+#pragma once
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+using namespace std;
+
+/**
+ * @brief Prefix routing tables and leaf sets for all machines
+ */
+class PastryRouter {
+public:
+    static constexpr int DEFAULT_DIGIT_BITS = 4;
+    static constexpr int DEFAULT_LEAF_SET = 16;
+    static constexpr int MAX_DIGIT_BITS = 8;
+
+    int digitBits;          // b: bits per digit, base 2^b
+    int leafSetSize;        // L: machines in the leaf set (L/2 per side)
+    int keyBits;            // Width of the identifier space
+    int rows;               // ceil(keyBits / b)
+    int cols;               // 2^b
+    vector<int> ids;        // Machine IDs, sorted
+    vector<int> table;      // [machine][row][col] -> index into ids, -1 = empty
+
+    PastryRouter() : digitBits(0), leafSetSize(DEFAULT_LEAF_SET), keyBits(0), rows(0), cols(0) {}
+
+    bool isEnabled() const { return digitBits > 0; }
+
+    /**
+     * @brief Turn Pastry routing on with base 2^b over a keyBits-wide space
+     */
+    void enable(int b, int leafSet, int identifierBits) {
+        digitBits = max(1, min(b, MAX_DIGIT_BITS));
+        leafSetSize = max(2, leafSet);
+        keyBits = identifierBits;
+        rows = (keyBits + digitBits - 1) / digitBits;
+        cols = 1 << digitBits;
+    }
+
+    void disable() {
+        digitBits = 0;
+        ids.clear();
+        table.clear();
+    }
+
+    /**
+     * @brief Recompute every routing table for the given sorted machine IDs
+     */
+    void rebuild(const vector<int>& sortedIds) {
+        ids = sortedIds;
+        size_t n = ids.size();
+        table.assign(n * static_cast<size_t>(rows * cols), -1);
+
+        for (size_t i = 0; i < n; i++) {
+            int* row = &table[i * static_cast<size_t>(rows * cols)];
+            for (int r = 0; r < rows; r++, row += cols) {
+                long long shift = static_cast<long long>(rows - r - 1) * digitBits;
+                long long prefix = static_cast<long long>(ids[i]) >> (shift + digitBits);
+                int own = digit(ids[i], r);
+                for (int d = 0; d < cols; d++) {
+                    if (d == own) continue;
+                    long long lo = ((prefix << digitBits) | d) << shift;
+                    long long hi = lo + (1LL << shift);
+                    auto it = lower_bound(ids.begin(), ids.end(), lo);
+                    if (it != ids.end() && *it < hi) row[d] = static_cast<int>(it - ids.begin());
+                }
+                // No other machine shares this prefix: deeper rows stay empty
+                long long ownLo = ((prefix << digitBits) | own) << shift;
+                auto first = lower_bound(ids.begin(), ids.end(), ownLo);
+                auto last = lower_bound(ids.begin(), ids.end(), ownLo + (1LL << shift));
+                if (last - first <= 1) break;
+            }
+        }
+    }
+
+    /**
+     * @brief Machine IDs visited from start to succ(key), start included
+     */
+    vector<int> route(int startId, int key) const {
+        vector<int> path;
+        size_t n = ids.size();
+        if (n == 0) return path;
+        size_t cur = indexOf(startId);
+        size_t owner = static_cast<size_t>(lower_bound(ids.begin(), ids.end(), key) - ids.begin()) % n;
+        path.push_back(ids[cur]);
+
+        size_t half = static_cast<size_t>(leafSetSize / 2);
+        for (int guard = 0; cur != owner && guard < rows + leafSetSize + 2; guard++) {
+            size_t ahead = (owner + n - cur) % n;
+            if (ahead <= half || n - ahead <= half) {
+                cur = owner;            // Owner is in the leaf set
+            } else {
+                int l = sharedDigits(ids[cur], key);
+                int next = l < rows ? entry(cur, l, digit(key, l)) : -1;
+                cur = next >= 0 ? static_cast<size_t>(next) : closestKnown(cur, owner);
+            }
+            path.push_back(ids[cur]);
+        }
+        return path;
+    }
+
+    /**
+     * @brief Non-empty routing table entries of one machine
+     */
+    int tableEntries(size_t index) const {
+        int count = 0;
+        const int* row = &table[index * static_cast<size_t>(rows * cols)];
+        for (int i = 0; i < rows * cols; i++) {
+            if (row[i] >= 0) count++;
+        }
+        return count;
+    }
+
+    /**
+     * @brief Routing state of one machine: table entries plus leaf set
+     */
+    int stateEntries(size_t index) const {
+        return tableEntries(index) + static_cast<int>(min(static_cast<size_t>(leafSetSize), ids.size() - 1));
+    }
+
+    size_t memoryBytes() const {
+        return (ids.capacity() + table.capacity()) * sizeof(int);
+    }
+
+    /**
+     * @brief Print the non-empty rows and the leaf set of one machine
+     */
+    void print(int machineId) const {
+        size_t i = indexOf(machineId);
+        if (i >= ids.size() || ids[i] != machineId) {
+            cout << "\n  ERROR: Machine " << machineId << " not found!\n";
+            return;
+        }
+        cout << "\n  +========================================================================+\n";
+        cout << "  |        PASTRY ROUTING TABLE - Machine " << setw(10) << left << machineId
+             << " (base 2^" << digitBits << ")            |\n";
+        cout << "  +------------------------------------------------------------------------+\n";
+        for (int r = 0; r < rows; r++) {
+            bool any = false;
+            for (int d = 0; d < cols; d++) any = any || entry(i, r, d) >= 0;
+            if (!any) continue;
+            cout << "  |  Row " << setw(2) << r << ":";
+            for (int d = 0; d < cols; d++) {
+                int e = entry(i, r, d);
+                if (e >= 0) cout << " " << d << "->" << ids[static_cast<size_t>(e)];
+            }
+            cout << "\n";
+        }
+        cout << "  |  Leaf set:";
+        size_t n = ids.size();
+        size_t half = min(static_cast<size_t>(leafSetSize / 2), (n - 1) / 2);
+        for (size_t k = half; k >= 1; k--) cout << " " << ids[(i + n - k) % n];
+        cout << " [" << machineId << "]";
+        for (size_t k = 1; k <= half; k++) cout << " " << ids[(i + k) % n];
+        cout << "\n  +========================================================================+\n";
+    }
+
+private:
+    size_t indexOf(int id) const {
+        return static_cast<size_t>(lower_bound(ids.begin(), ids.end(), id) - ids.begin());
+    }
+
+    int digit(int value, int r) const {
+        int shift = (rows - r - 1) * digitBits;
+        return (value >> shift) & (cols - 1);
+    }
+
+    int entry(size_t index, int r, int d) const {
+        return table[index * static_cast<size_t>(rows * cols) + static_cast<size_t>(r * cols + d)];
+    }
+
+    int sharedDigits(int a, int b) const {
+        int r = 0;
+        while (r < rows && digit(a, r) == digit(b, r)) r++;
+        return r;
+    }
+
+    /**
+     * @brief Rare case with no matching entry: the known machine (table or
+     *        leaf set) that is the fewest ring positions before the owner
+     */
+    size_t closestKnown(size_t cur, size_t owner) const {
+        size_t n = ids.size();
+        size_t best = (cur + 1) % n;
+        auto gap = [&](size_t x) { return (owner + n - x) % n; };
+        const int* row = &table[cur * static_cast<size_t>(rows * cols)];
+        for (int i = 0; i < rows * cols; i++) {
+            if (row[i] >= 0 && gap(static_cast<size_t>(row[i])) < gap(best)) best = static_cast<size_t>(row[i]);
+        }
+        size_t forward = (cur + static_cast<size_t>(leafSetSize / 2)) % n;
+        if (gap(forward) < gap(best)) best = forward;
+        return best;
+    }
+};
@@ -0,0 +1,181 @@
+/**
+ * @file PlacementEngine.h
+ * @brief O(1) key-to-machine placement: jump consistent hash or Maglev table
+ * @details An alternative to Chord arcs. Jump hash maps a key to one of N
+ *          buckets with no table at all; buckets hold machine IDs in join
+ *          order, so a join moves ~1/N of the keys, but a leave other than
+ *          the newest machine swaps the last bucket into the hole and moves
+ *          ~2/N. Maglev fills a prime-sized table from a per-machine
+ *          permutation; lookup is one array read. The table size is fixed
+ *          when Maglev is enabled, so a join or leave only refills the
+ *          table and moves close to 1/N of the keys.
+ *
+ * Compile: g++ -std=c++17 -Wall -o ipfs_dht src/main.cpp
+ */
+
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+using namespace std;
+
+/**
+ * @brief How keys are assigned to machines
+ */
+enum class PlacementMode {
+    Ring,       // Successor of the key on the Chord ring (default)
+    Jump,       // Jump consistent hash over the machine list
+    Maglev      // Maglev lookup table over the machine list
+};
+
+/**
+ * @brief Key-to-machine map kept in sync with ring membership
+ */
+class PlacementEngine {
+public:
+    static constexpr int MAGLEV_ENTRIES_PER_MACHINE = 100;  // Minimum table size / N
+    static constexpr int MAGLEV_MIN_ENTRIES = 65537;        // Prime; >= 100 slots each up to 655 machines
+
+    PlacementMode mode;
+    vector<int> buckets;        // Jump: machine ID per bucket, in join order
+    vector<int> machines;       // Maglev: machine IDs, sorted
+    vector<int> table;          // Maglev: table slot -> index into machines
+    size_t maglevSize;          // Maglev: prime table size, fixed while the mode is on
+
+    PlacementEngine() : mode(PlacementMode::Ring), maglevSize(0) {}
+
+    bool isEnabled() const { return mode != PlacementMode::Ring; }
+
+    const char* name() const {
+        switch (mode) {
+            case PlacementMode::Jump: return "Jump hash";
+            case PlacementMode::Maglev: return "Maglev";
+            default: return "Chord ring";
+        }
+    }
+
+    /**
+     * @brief Switch mode and place the given machines
+     */
+    void enable(PlacementMode newMode, const vector<int>& ids) {
+        mode = newMode;
+        buckets.clear();
+        machines.clear();
+        table.clear();
+
+        // A new size would remap every key, so pick it once for the largest expected N
+        size_t wanted = max(static_cast<size_t>(MAGLEV_MIN_ENTRIES),
+                            ids.size() * static_cast<size_t>(MAGLEV_ENTRIES_PER_MACHINE));
+        maglevSize = wanted;
+        while (!isPrime(maglevSize)) maglevSize++;
+        if (isEnabled()) update(ids, {});
+    }
+
+    /**
+     * @brief Apply leaves, then joins, then rebuild once
+     */
+    void update(const vector<int>& joins, const vector<int>& leaves) {
+        if (mode == PlacementMode::Jump) {
+            for (int id : leaves) {
+                auto it = find(buckets.begin(), buckets.end(), id);
+                if (it == buckets.end()) continue;
+                *it = buckets.back();       // Only the last bucket can vanish
+                buckets.pop_back();
+            }
+            for (int id : joins) buckets.push_back(id);
+        } else if (mode == PlacementMode::Maglev) {
+            for (int id : leaves) {
+                auto it = lower_bound(machines.begin(), machines.end(), id);
+                if (it != machines.end() && *it == id) machines.erase(it);
+            }
+            for (int id : joins) {
+                auto it = lower_bound(machines.begin(), machines.end(), id);
+                if (it == machines.end() || *it != id) machines.insert(it, id);
+            }
+            buildMaglevTable();
+        }
+    }
+
+    /**
+     * @brief Machine ID owning a key, or -1 when there are no machines
+     */
+    int ownerOf(int key) const {
+        uint64_t hash = mix(static_cast<uint64_t>(key));
+        if (mode == PlacementMode::Jump) {
+            if (buckets.empty()) return -1;
+            return buckets[static_cast<size_t>(jumpHash(hash, static_cast<int32_t>(buckets.size())))];
+        }
+        if (table.empty()) return -1;
+        return machines[static_cast<size_t>(table[hash % table.size()])];
+    }
+
+    size_t memoryBytes() const {
+        return (buckets.capacity() + machines.capacity() + table.capacity()) * sizeof(int);
+    }
+
+    /**
+     * @brief 64-bit finalizer (splitmix64); spreads small integer keys
+     */
+    static uint64_t mix(uint64_t x) {
+        x += 0x9E3779B97F4A7C15ULL;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        return x ^ (x >> 31);
+    }
+
+    /**
+     * @brief Lamping & Veach jump consistent hash: bucket in [0, numBuckets)
+     */
+    static int32_t jumpHash(uint64_t key, int32_t numBuckets) {
+        int64_t b = -1, j = 0;
+        while (j < numBuckets) {
+            b = j;
+            key = key * 2862933555777941757ULL + 1;
+            j = static_cast<int64_t>(static_cast<double>(b + 1) *
+                                     (static_cast<double>(1LL << 31) / static_cast<double>((key >> 33) + 1)));
+        }
+        return static_cast<int32_t>(b);
+    }
+
+private:
+    static bool isPrime(size_t n) {
+        if (n < 2) return false;
+        for (size_t d = 2; d * d <= n; d++) {
+            if (n % d == 0) return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Fill the table: machines take turns claiming their next free
+     *        preferred slot, so every machine gets M/N slots (+-1)
+     */
+    void buildMaglevTable() {
+        table.clear();
+        if (machines.empty()) return;
+
+        size_t size = maglevSize;
+        size_t n = machines.size();
+        vector<uint64_t> offset(n), skip(n), next(n, 0);
+        for (size_t i = 0; i < n; i++) {
+            uint64_t id = static_cast<uint64_t>(machines[i]);
+            offset[i] = mix(id) % size;
+            skip[i] = mix(id ^ 0x5BD1E995ULL) % (size - 1) + 1;
+        }
+
+        table.assign(size, -1);
+        size_t filled = 0;
+        while (true) {
+            for (size_t i = 0; i < n; i++) {
+                size_t slot = (offset[i] + next[i] * skip[i]) % size;
+                while (table[slot] >= 0) {
+                    next[i]++;
+                    slot = (offset[i] + next[i] * skip[i]) % size;
+                }
+                table[slot] = static_cast<int>(i);
+                next[i]++;
+                if (++filled == size) return;
+            }
+        }
+    }
+};
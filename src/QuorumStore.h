@@ -0,0 +1,387 @@
+/**
+ * @file QuorumStore.h
+ * @brief Tunable N/R/W quorum reads and writes over the replica sets
+ * @details N is the replication factor: the primary plus its replica set.
+ *          A put is stamped with a new version and sent to all N replicas,
+ *          succeeding once W of them acknowledge. A get asks all N and
+ *          returns the freshest version among the first R replies. Latency
+ *          is the W-th (R-th) fastest round trip under LatencyModel.
+ *          Versions are Lamport timestamps: every machine keeps a counter,
+ *          the coordinator of a put (the first reachable machine of the
+ *          key's preference list) stamps (counter + 1, its ID), and every
+ *          message and reply advances the receiver's counter past the
+ *          versions it carries. With read repair on, a get compares all N
+ *          replies (the late ones too) and sends the freshest copy to every
+ *          replica that answered with an older one or none. Repairs leave
+ *          after the reply and are applied before the next operation.
+ *          Machines can be marked unreachable. With a strict quorum they
+ *          simply do not answer. With a sloppy quorum, each unreachable
+ *          replica is stood in for by the next reachable machine after the
+ *          replica set on the ring. The stand-in keeps the write as a hint
+ *          and answers reads from it, and recover() hands the hints to the
+ *          replica when it comes back (hinted handoff). Membership changes
+ *          reconcile replicas from the primaries, so recover machines before
+ *          changing membership.
+ *
+ * Compile: g++ -std=c++17 -Wall -o ipfs_dht src/main.cpp
+ */
+
+#pragma once
+#include <algorithm>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "CircularLL.h"
+#include "LatencySimulator.h"
+using namespace std;
+
+/**
+ * @brief Outcome of one quorum put or get
+ */
+struct QuorumResult {
+    bool ok;                // W (R) replicas answered
+    bool found;             // Get: one of the first R replies held the key
+    double latencyUs;       // Round trip of the W-th (R-th) fastest reply; 0 if not ok
+    long long version;      // Put: version written. Get: freshest version read (0 = unversioned or not found)
+    int replies;            // Replicas (or stand-ins) that answered
+    int hinted;             // Put: copies parked on stand-ins for unreachable replicas
+    FileNode* file;         // Get: freshest copy among the first R replies
+};
+
+/**
+ * @brief Quorum coordinator for a replicated ring
+ */
+class QuorumStore {
+public:
+    CircularLinkedList* ring;
+    LatencyModel& latency;
+    int readQuorum;         // R
+    int writeQuorum;        // W
+    bool sloppy;            // Stand-ins take over for unreachable replicas
+    bool readRepair;        // Gets repair replicas that answered with older copies
+    set<int> down;          // Unreachable machine IDs
+    long long hintsDelivered;
+    long long staleReplies; // Get replies older than the freshest copy (or missing it)
+    long long repairs;      // Repair messages sent
+    long long repairBytes;  // File bytes carried by repairs
+
+    QuorumStore(CircularLinkedList* r, LatencyModel& model, int reads, int writes, bool sloppyQuorum = true)
+        : ring(r), latency(model), readQuorum(reads), writeQuorum(writes), sloppy(sloppyQuorum), readRepair(false),
+          hintsDelivered(0), staleReplies(0), repairs(0), repairBytes(0) {}
+
+    /**
+     * @brief Lamport version: counter in the high bits, writer ID as tie-break
+     */
+    static long long stamp(long long counter, int machineId) {
+        return (counter << 31) | static_cast<long long>(machineId);
+    }
+
+    static long long counterOf(long long version) { return version >> 31; }
+
+    /**
+     * @brief Lamport counter of a machine
+     */
+    long long clockOf(int machineId) const {
+        auto it = clocks.find(machineId);
+        return it != clocks.end() ? it->second : 0;
+    }
+
+    /**
+     * @brief N: primary plus replicas
+     */
+    int replicationFactor() const {
+        return ring->replicas.isEnabled() ? ring->replicas.factor : 1;
+    }
+
+    bool isUp(int machineId) const { return down.count(machineId) == 0; }
+
+    void fail(int machineId) { down.insert(machineId); }
+
+    /**
+     * @brief Machine reachable again: deliver the hints stand-ins kept for it
+     * @return Hints delivered
+     */
+    int recover(int machineId) {
+        applyRepairs();
+        down.erase(machineId);
+        CircularNode* target = ring->findMachineById(machineId);
+        int delivered = 0;
+        for (auto& entry : hints) {
+            vector<Hint>& held = entry.second;
+            for (size_t i = 0; i < held.size();) {
+                if (held[i].target != machineId) {
+                    i++;
+                    continue;
+                }
+                if (target != nullptr) {
+                    observe(machineId, held[i].file.version);
+                    storeCopy(target, held[i].file);
+                }
+                held[i] = held.back();
+                held.pop_back();
+                delivered++;
+            }
+        }
+        hintsDelivered += delivered;
+        return delivered;
+    }
+
+    /**
+     * @brief Hints currently parked on stand-ins
+     */
+    size_t pendingHints() const {
+        size_t total = 0;
+        for (const auto& entry : hints) total += entry.second.size();
+        return total;
+    }
+
+    /**
+     * @brief Write a new version of key; ok once W replicas acknowledged
+     * @details The client's machine forwards the put to the first reachable
+     *          machine of the preference list, which stamps the version and
+     *          sends it to the rest. That machine has seen every earlier
+     *          write of the key it took part in, so its stamp orders after them.
+     */
+    QuorumResult put(int origin, int key, const string& path, long long size = 0) {
+        applyRepairs();
+        QuorumResult result = { false, false, 0, 0, 0, 0, nullptr };
+        vector<Target> replicas = targets(key);
+        if (replicas.empty()) return result;
+        CircularNode* coordinator = replicas.front().machine;
+        double forward = roundTrip(origin, coordinator);
+        FileNode file(key, path, size);
+        file.version = stamp(++clocks[coordinator->key], coordinator->key);
+        result.version = file.version;
+
+        vector<double> acks;
+        for (const Target& t : replicas) {
+            observe(t.machine->key, file.version);
+            if (t.machine->key == t.replica) {
+                storeCopy(t.machine, file);
+            } else {
+                parkHint(t.machine, t.replica, file);
+                result.hinted++;
+            }
+            acks.push_back(forward + roundTrip(coordinator->key, t.machine));
+            observe(coordinator->key, stamp(clockOf(t.machine->key), t.machine->key));
+        }
+        observe(origin, file.version);
+        return finish(result, acks, writeQuorum);
+    }
+
+    /**
+     * @brief Read key; the freshest version among the first R replies
+     */
+    QuorumResult get(int origin, int key) {
+        applyRepairs();
+        QuorumResult result = { false, false, 0, 0, 0, 0, nullptr };
+        vector<Reply> replies;
+        for (const Target& t : targets(key)) {
+            FileNode* copy = t.machine->key == t.replica ? findCopy(t.machine, key) : findHint(t.machine, key, t.replica);
+            replies.push_back({ roundTrip(origin, t.machine), t, copy });
+        }
+        sort(replies.begin(), replies.end(), [](const Reply& a, const Reply& b) { return a.time < b.time; });
+
+        vector<double> times;
+        FileNode* newest = nullptr;     // Freshest of all N replies, late ones included
+        for (size_t i = 0; i < replies.size(); i++) {
+            times.push_back(replies[i].time);
+            FileNode* copy = replies[i].copy;
+            observe(origin, stamp(clockOf(replies[i].target.machine->key), replies[i].target.machine->key));
+            if (copy == nullptr) continue;
+            observe(origin, copy->version);
+            if (newest == nullptr || copy->version > newest->version) newest = copy;
+            if (i < static_cast<size_t>(readQuorum) && (result.file == nullptr || copy->version > result.file->version)) {
+                result.found = true;
+                result.file = copy;
+                result.version = copy->version;
+            }
+        }
+        if (newest != nullptr) {
+            for (const Reply& r : replies) {
+                if (r.copy != nullptr && r.copy->version >= newest->version) continue;
+                staleReplies++;
+                if (readRepair) pendingRepairs.push_back({ r.target.machine->key, r.target.replica, *newest });
+            }
+        }
+        return finish(result, times, readQuorum);
+    }
+
+    /**
+     * @brief Deliver the read repairs sent so far (to machines still reachable)
+     * @return Repairs applied
+     */
+    int applyRepairs() {
+        int applied = 0;
+        for (const Repair& r : pendingRepairs) {
+            CircularNode* machine = isUp(r.machine) ? ring->findMachineById(r.machine) : nullptr;
+            repairs++;
+            repairBytes += r.file.size;
+            if (machine == nullptr) continue;
+            observe(r.machine, r.file.version);
+            if (r.machine == r.replica) {
+                storeCopy(machine, r.file);
+            } else {
+                parkHint(machine, r.replica, r.file);
+            }
+            applied++;
+        }
+        pendingRepairs.clear();
+        return applied;
+    }
+
+private:
+    /**
+     * @brief Copy held by a stand-in for an unreachable replica
+     */
+    struct Hint {
+        int target;         // Replica the copy belongs to
+        FileNode file;
+    };
+
+    /**
+     * @brief Machine asked for one of the N replicas (itself or its stand-in)
+     */
+    struct Target {
+        CircularNode* machine;
+        int replica;
+    };
+
+    /**
+     * @brief One replica's answer to a get
+     */
+    struct Reply {
+        double time;        // Round trip from the coordinator
+        Target target;
+        FileNode* copy;     // nullptr if it holds none
+    };
+
+    /**
+     * @brief Freshest copy on its way to a replica that answered with an older one
+     */
+    struct Repair {
+        int machine;        // Machine that answered (replica or stand-in)
+        int replica;
+        FileNode file;
+    };
+
+    unordered_map<int, vector<Hint>> hints;     // Stand-in machine ID -> hints it holds
+    unordered_map<int, long long> clocks;       // Machine ID -> Lamport counter
+    vector<Repair> pendingRepairs;              // Sent by gets, applied before the next operation
+
+    /**
+     * @brief machineId receives a message carrying version: advance its counter past it
+     */
+    void observe(int machineId, long long version) {
+        long long& counter = clocks[machineId];
+        counter = max(counter, counterOf(version));
+    }
+
+    /**
+     * @brief Reachable machines to contact for key: replicas that are up,
+     *        plus stand-ins for the ones that are down (sloppy only)
+     */
+    vector<Target> targets(int key) {
+        vector<Target> result;
+        CircularNode* primary = ring->head != nullptr ? ring->ownerOf(key) : nullptr;
+        if (primary == nullptr) return result;
+        vector<CircularNode*> preference = { primary };
+        for (CircularNode* m : ring->replicaSet(key)) preference.push_back(m);
+
+        CircularNode* standIn = preference.back();
+        size_t machines = static_cast<size_t>(ring->getMachineCount());
+        for (CircularNode* replica : preference) {
+            if (isUp(replica->key)) {
+                result.push_back({ replica, replica->key });
+                continue;
+            }
+            if (!sloppy) continue;
+            // Next reachable machine past the replica set that is not already used
+            for (size_t step = 0; step < machines; step++) {
+                standIn = standIn->next;
+                bool used = find(preference.begin(), preference.end(), standIn) != preference.end();
+                if (!used && isUp(standIn->key)) {
+                    result.push_back({ standIn, replica->key });
+                    break;
+                }
+            }
+        }
+        return result;
+    }
+
+    double roundTrip(int origin, CircularNode* machine) {
+        if (machine->key == origin) return 0;
+        return latency.message(origin, machine->key) + latency.message(machine->key, origin);
+    }
+
+    /**
+     * @brief Store file on machine as primary or replica copy, keeping the newer version
+     * @details With the block store on, a primary copy's bytes are appended to
+     *          the machine's log and the record of the version it replaces is
+     *          released. Replica copies keep their index entry only.
+     */
+    void storeCopy(CircularNode* machine, const FileNode& file) {
+        bool primary = ring->ownerOf(file.key) == machine;
+        BTree& tree = primary ? machine->BTreeroot : machine->replicaStore;
+        FileNode* existing = tree.findFile(file.key);
+        if (existing == nullptr) {
+            FileNode copy = file;
+            copy.segment = -1;      // A record location is only valid in the log that wrote it
+            copy.offset = 0;
+            if (primary) ring->storeBlock(machine, copy, nullptr);
+            tree.insertHelper(copy, ring->btreeOrder);
+        } else if (file.version > existing->version) {
+            if (primary) ring->releaseBlock(machine, file.key);
+            existing->path = file.path;
+            existing->size = file.size;
+            existing->version = file.version;
+            if (primary) {
+                ring->storeBlock(machine, *existing, nullptr);
+                compactBlocks(machine);
+            }
+        } else {
+            return;
+        }
+        if (primary) ring->invalidateMiss(file.key);    // Origins that cached the miss must route again
+    }
+
+    /**
+     * @brief Keep file on a stand-in for replica, replacing an older hint for the same key
+     */
+    void parkHint(CircularNode* standIn, int replica, const FileNode& file) {
+        vector<Hint>& held = hints[standIn->key];
+        for (Hint& h : held) {
+            if (h.target == replica && h.file.key == file.key) {
+                if (file.version > h.file.version) h.file = file;
+                return;
+            }
+        }
+        held.push_back({ replica, file });
+    }
+
+    FileNode* findCopy(CircularNode* machine, int key) {
+        FileNode* copy = machine->BTreeroot.findFile(key);
+        return copy != nullptr ? copy : machine->replicaStore.findFile(key);
+    }
+
+    FileNode* findHint(CircularNode* machine, int key, int replica) {
+        auto it = hints.find(machine->key);
+        if (it == hints.end()) return nullptr;
+        for (Hint& h : it->second) {
+            if (h.target == replica && h.file.key == key) return &h.file;
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief ok and latency from the reply times, given the quorum size
+     */
+    static QuorumResult finish(QuorumResult result, vector<double>& times, int quorum) {
+        sort(times.begin(), times.end());
+        result.replies = static_cast<int>(times.size());
+        result.ok = quorum <= result.replies;
+        result.latencyUs = result.ok ? times[static_cast<size_t>(max(quorum, 1) - 1)] : 0;
+        return result;
+    }
+};
@@ -0,0 +1,226 @@
+/**
+ * @file Rebalancer.h
+ * @brief Bandwidth-throttled background rebalancer for file handoffs
+ * @details Instead of moving files synchronously when a machine joins, the
+ *          ring records the key range the new machine took over and the
+ *          machines holding it (one batch per join). step() walks each range
+ *          through the holders' B-trees, resuming where the last call
+ *          stopped, and a token bucket limits how many bytes and files it
+ *          may transfer per second. Batches that foreground reads keep
+ *          hitting are moved first. Until a range is done, readers that miss
+ *          at the new owner look at its holders.
+ *
+ * Compile: g++ -std=c++17 -Wall -o ipfs_dht src/main.cpp
+ */
+
+#pragma once
+#include <algorithm>
+#include <vector>
+#include "BTree.h"
+using namespace std;
+
+/**
+ * @brief Token bucket over one resource (bytes or files)
+ * @details rate <= 0 means unlimited. The bucket holds at most burstSeconds
+ *          worth of tokens so an idle period cannot turn into a spike.
+ */
+class TokenBucket {
+public:
+    double rate;            // Tokens per second
+    double capacity;        // Maximum stored tokens
+    double tokens;
+
+    TokenBucket() : rate(0), capacity(0), tokens(0) {}
+
+    void configure(double perSecond, double burstSeconds) {
+        rate = perSecond;
+        capacity = max(1.0, perSecond * burstSeconds);
+        tokens = 0;
+    }
+
+    bool isLimited() const { return rate > 0; }
+
+    void refill(double seconds) {
+        if (isLimited()) tokens = min(capacity, tokens + rate * seconds);
+    }
+
+    /**
+     * @brief Items larger than the bucket go through once it is full
+     */
+    bool canSpend(double amount) const { return !isLimited() || tokens >= min(amount, capacity); }
+
+    void spend(double amount) {
+        if (isLimited()) tokens -= amount;
+    }
+};
+
+/**
+ * @brief Queue of pending range handoffs drained under a bandwidth budget
+ */
+class Rebalancer {
+public:
+    /**
+     * @brief Key range (fromKey, toMachine] that one join took over
+     * @details The range is scanned lazily: each step() resumes at the first
+     *          file after cursor on the current source machine, so a join
+     *          costs O(1) and every move O(log F).
+     */
+    struct Batch {
+        int id;
+        int toMachine;          // Machine that joined; inclusive end of the range
+        int fromKey;            // Exclusive start of the range
+        vector<int> sources;    // Machines that may hold files of the range
+        size_t source;          // sources[0, source) fully scanned
+        int cursor;             // Next file to move is the first key after this
+        bool wrapped;           // Range wraps past 0 and the scan is past it
+        long long heat;         // Foreground reads that hit a pending file
+
+        bool contains(int key) const {
+            return fromKey < toMachine ? (key > fromKey && key <= toMachine)
+                                       : (key > fromKey || key <= toMachine);
+        }
+    };
+
+    static constexpr double BURST_SECONDS = 0.1;
+
+    bool enabled;
+    bool hotFirst;              // Move batches with the most foreground reads first
+    TokenBucket bytes;
+    TokenBucket files;
+    vector<Batch> batches;
+    int nextBatchId;
+
+    // Progress counters
+    long long rangesQueued;
+    long long filesMoved;
+    long long bytesMoved;
+
+    Rebalancer() : enabled(false), hotFirst(true), nextBatchId(0), rangesQueued(0), filesMoved(0), bytesMoved(0) {}
+
+    bool isEnabled() const { return enabled; }
+
+    /**
+     * @brief Turn on background moves with the given budget (<= 0 = unlimited)
+     */
+    void enable(double bytesPerSecond, double filesPerSecond) {
+        enabled = true;
+        bytes.configure(bytesPerSecond, BURST_SECONDS);
+        files.configure(filesPerSecond, BURST_SECONDS);
+    }
+
+    bool isIdle() const { return batches.empty(); }
+
+    /**
+     * @brief Ranges not fully handed over yet
+     */
+    size_t pendingCount() const { return batches.size(); }
+
+    /**
+     * @brief Queue the range (fromKey, toMachine] held by sources (in ring order)
+     */
+    void queueRange(int fromKey, int toMachine, const vector<int>& sources) {
+        batches.push_back({ nextBatchId++, toMachine, fromKey, sources, 0, fromKey, false, 0 });
+        rangesQueued++;
+    }
+
+    /**
+     * @brief Machines that may still hold a pending file; counts the read as heat
+     */
+    vector<int> holdersOf(int fileKey) {
+        vector<int> holders;
+        for (Batch& batch : batches) {
+            if (!batch.contains(fileKey)) continue;
+            batch.heat++;
+            holders.insert(holders.end(), batch.sources.begin() + static_cast<long>(batch.source),
+                           batch.sources.end());
+        }
+        return holders;
+    }
+
+    /**
+     * @brief Move files for the given elapsed time, hottest batch first
+     * @tparam Ring Provides findMachineById(), succ(), drainTarget() and transferFile()
+     * @return Number of files moved
+     */
+    template<class Ring>
+    int step(Ring& ring, double seconds, int order) {
+        bytes.refill(seconds);
+        files.refill(seconds);
+        int moved = 0;
+
+        while (!batches.empty()) {
+            auto hottest = !hotFirst ? batches.begin() : max_element(batches.begin(), batches.end(),
+                [](const Batch& a, const Batch& b) { return a.heat < b.heat; });
+            Batch& batch = *hottest;
+
+            while (batch.source < batch.sources.size()) {
+                auto* holder = ring.findMachineById(batch.sources[batch.source]);
+                FileNode* file = holder ? nextInRange(holder->BTreeroot, batch) : nullptr;
+                if (file == nullptr) {
+                    batch.source++;         // This source has nothing left in the range
+                    batch.cursor = batch.fromKey;
+                    batch.wrapped = false;
+                    continue;
+                }
+
+                double cost = static_cast<double>(file->size > 0 ? file->size : 1);
+                if (!bytes.canSpend(cost) || !files.canSpend(1)) return moved;
+
+                int key = file->key;
+                auto* owner = ring.drainTarget(ring.succ(key));
+                if (owner != nullptr && owner != holder) {
+                    bytesMoved += file->size;
+                    ring.transferFile(holder, owner, key, order);
+                    filesMoved++;
+                    moved++;
+                }
+                bytes.spend(cost);
+                files.spend(1);
+                batch.cursor = key;
+            }
+            batches.erase(hottest);
+        }
+        return moved;
+    }
+
+    /**
+     * @brief Finish every pending move now, ignoring the budget
+     */
+    template<class Ring>
+    int flush(Ring& ring, int order) {
+        if (batches.empty()) return 0;
+        TokenBucket savedBytes = bytes;
+        TokenBucket savedFiles = files;
+        bytes.rate = 0;
+        files.rate = 0;
+        int moved = step(ring, 0, order);
+        bytes = savedBytes;
+        files = savedFiles;
+        return moved;
+    }
+
+    size_t memoryBytes() const {
+        size_t total = 0;
+        for (const Batch& batch : batches) total += sizeof(Batch) + batch.sources.capacity() * sizeof(int);
+        return total;
+    }
+
+private:
+    /**
+     * @brief First file of tree after batch.cursor inside the batch's range
+     */
+    static FileNode* nextInRange(BTree& tree, Batch& batch) {
+        if (batch.fromKey < batch.toMachine) {
+            FileNode* file = tree.findNextFile(batch.cursor);
+            return file != nullptr && file->key <= batch.toMachine ? file : nullptr;
+        }
+        if (!batch.wrapped) {
+            FileNode* file = tree.findNextFile(batch.cursor);
+            if (file != nullptr) return file;
+            batch.wrapped = true;           // Continue from key 0
+            batch.cursor = -1;
+        }
+        FileNode* file = tree.findNextFile(batch.cursor);
+        return file != nullptr && file->key <= batch.toMachine ? file : nullptr;
+    }
+};
@@ -0,0 +1,313 @@
+/**
+ * @file ReplicaSelector.h
+ * @brief Rendezvous (highest random weight) selection of replica machines
+ * @details Every machine gets a score hash(key, machine) and the R highest
+ *          scores hold the replicas, so a join or leave only changes the
+ *          replica sets it wins or loses. The flat variant scores all N
+ *          machines in one branch-free loop over a contiguous seed array,
+ *          which the compiler vectorizes. The skeleton variant descends a
+ *          tree of virtual groups (8 children per level) by HRW over the
+ *          non-empty children, then takes the best machine in the leaf, for
+ *          O(log N) work per replica. Each machine joins 8 leaves picked by
+ *          HRW on its own ID, so while the shape holds a join or leave only
+ *          moves keys into or out of its own leaves (~1/N of them).
+ *
+ *          Growth limit: the depth is chosen for about LEAF_SIZE members per
+ *          leaf. Leaves grow with N, and once they average more than
+ *          MAX_LEAF_LOAD members update() adds levels until they are back
+ *          near LEAF_SIZE. That one change reassigns most replica sets; it
+ *          happens each time N grows 4-32x. Leaves never make the skeleton
+ *          shallower.
+ *
+ * Compile: g++ -std=c++17 -Wall -o ipfs_dht src/main.cpp
+ */
+
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+using namespace std;
+
+/**
+ * @brief Where the copies of a file beyond its primary are kept
+ */
+enum class ReplicaMode {
+    None,
+    SuccessorList,      // Next R-1 machines after the primary on the ring
+    Rendezvous,         // Top R-1 HRW scores over all machines
+    Skeleton            // HRW descent through a virtual skeleton, O(log N)
+};
+
+/**
+ * @brief HRW replica selector over the current machine IDs
+ */
+class ReplicaSelector {
+public:
+    static constexpr int MAX_FACTOR = 8;
+    static constexpr int FANOUT = 8;            // Children per skeleton level
+    static constexpr size_t LEAF_SIZE = 64;     // Target members per leaf when (re)sized
+    static constexpr size_t MAX_LEAF_LOAD = 4 * LEAF_SIZE;  // Average leaf load that triggers a deeper skeleton
+    static constexpr size_t MACHINE_LEAVES = 8; // Leaves each machine joins; evens out leaf sizes
+    static constexpr size_t MIN_LEAVES = 8;
+
+    /**
+     * @brief Skeleton tree node; children of node i are FANOUT * i + 1 ..
+     *        FANOUT * i + FANOUT, so only leaves store anything beyond a label
+     */
+    struct SkeletonNode {
+        uint32_t label;             // Seed scored against the key
+        size_t weight;              // Leaf memberships below this node
+        vector<int> members;        // Indices into ids (leaves only)
+    };
+
+    ReplicaMode mode;
+    int factor;                     // Total copies including the primary
+    vector<int> ids;                // Machine IDs, sorted
+    vector<uint32_t> seeds;         // seeds[i] = mix32(ids[i])
+    vector<SkeletonNode> skeleton;  // skeleton[0] is the root; deepened only past MAX_LEAF_LOAD
+    size_t firstLeaf;               // Index of the first leaf in skeleton
+    int reshapes;                   // Times update() deepened the skeleton
+
+    ReplicaSelector() : mode(ReplicaMode::None), factor(1), firstLeaf(0), reshapes(0) {}
+
+    bool isEnabled() const { return mode != ReplicaMode::None && factor > 1; }
+
+    const char* name() const {
+        switch (mode) {
+            case ReplicaMode::SuccessorList: return "Successor list";
+            case ReplicaMode::Rendezvous: return "Rendezvous";
+            case ReplicaMode::Skeleton: return "HRW skeleton";
+            default: return "None";
+        }
+    }
+
+    void configure(ReplicaMode newMode, int replicationFactor, const vector<int>& machineIds) {
+        mode = newMode;
+        factor = max(1, min(replicationFactor, MAX_FACTOR));
+        ids.clear();
+        skeleton.clear();
+        firstLeaf = 0;
+        reshapes = 0;
+        if (mode == ReplicaMode::Skeleton) shapeSkeleton(machineIds.size());
+        update(machineIds, {});
+    }
+
+    /**
+     * @brief Apply joins and leaves with one sort/merge, then rebuild seeds
+     *        and skeleton weights once
+     * @details O(N + J log J + L log L) for J joins and L leaves.
+     */
+    void update(const vector<int>& joins, const vector<int>& leaves) {
+        if (!leaves.empty()) {
+            vector<int> gone(leaves);
+            sort(gone.begin(), gone.end());
+            vector<int> kept;
+            kept.reserve(ids.size());
+            set_difference(ids.begin(), ids.end(), gone.begin(), gone.end(), back_inserter(kept));
+            ids.swap(kept);
+        }
+        if (!joins.empty()) {
+            vector<int> added(joins);
+            sort(added.begin(), added.end());
+            vector<int> merged;
+            merged.reserve(ids.size() + added.size());
+            set_union(ids.begin(), ids.end(), added.begin(), added.end(), back_inserter(merged));
+            merged.erase(unique(merged.begin(), merged.end()), merged.end());
+            ids.swap(merged);
+        }
+        seeds.resize(ids.size());
+        for (size_t i = 0; i < ids.size(); i++) seeds[i] = mix32(static_cast<uint32_t>(ids[i]));
+
+        if (skeleton.empty()) return;
+        size_t leafCount = skeleton.size() - firstLeaf;
+        if (ids.size() * MACHINE_LEAVES > leafCount * MAX_LEAF_LOAD) {
+            shapeSkeleton(ids.size());
+            reshapes++;
+        }
+        assignLeaves();
+    }
+
+    /**
+     * @brief Levels below the root
+     */
+    int depth() const {
+        int levels = 0;
+        for (size_t node = firstLeaf; node > 0; node = (node - 1) / FANOUT) levels++;
+        return levels;
+    }
+
+    /**
+     * @brief Average leaf memberships (MACHINE_LEAVES per machine)
+     */
+    double leafLoad() const {
+        if (skeleton.empty()) return 0;
+        return static_cast<double>(skeleton[0].weight) / static_cast<double>(skeleton.size() - firstLeaf);
+    }
+
+    /**
+     * @brief Up to count machines for a key by HRW, never `exclude`
+     */
+    vector<int> select(int key, size_t count, int exclude) const {
+        vector<int> result;
+        if (ids.empty() || count == 0) return result;
+        uint32_t h = mix32(static_cast<uint32_t>(key) ^ 0x9E3779B9u);
+        if (mode == ReplicaMode::Skeleton) {
+            vector<int> chosen;
+            auto it = lower_bound(ids.begin(), ids.end(), exclude);
+            if (it != ids.end() && *it == exclude) chosen.push_back(static_cast<int>(it - ids.begin()));
+            for (size_t r = 0; r < count; r++) {
+                // A fresh hash per replica spreads copies over different subtrees
+                int pick = descend(0, mix32(h + static_cast<uint32_t>(r) * 0x85EBCA6Bu), chosen);
+                if (pick < 0) break;
+                chosen.push_back(pick);
+                result.push_back(ids[static_cast<size_t>(pick)]);
+            }
+            return result;
+        }
+        return topScores(h, count, exclude);
+    }
+
+    /**
+     * @brief Murmur3 32-bit finalizer
+     */
+    static uint32_t mix32(uint32_t x) {
+        x ^= x >> 16;
+        x *= 0x85EBCA6Bu;
+        x ^= x >> 13;
+        x *= 0xC2B2AE35u;
+        x ^= x >> 16;
+        return x;
+    }
+
+    size_t memoryBytes() const {
+        size_t total = ids.capacity() * sizeof(int) + seeds.capacity() * sizeof(uint32_t);
+        for (const SkeletonNode& node : skeleton) {
+            total += sizeof(SkeletonNode) + node.members.capacity() * sizeof(int);
+        }
+        return total;
+    }
+
+private:
+    /**
+     * @brief Size the tree for about LEAF_SIZE members per leaf with n machines
+     * @details Node labels depend only on the node index, so the upper levels
+     *          keep their labels; the leaf level and below are new.
+     */
+    void shapeSkeleton(size_t n) {
+        size_t leaves = 1, nodes = 1;
+        firstLeaf = 0;
+        while (leaves < MIN_LEAVES || leaves * LEAF_SIZE < n * MACHINE_LEAVES) {
+            firstLeaf = nodes;
+            leaves *= FANOUT;
+            nodes += leaves;
+        }
+        skeleton.resize(nodes);
+        for (size_t i = 0; i < nodes; i++) {
+            skeleton[i].label = mix32(static_cast<uint32_t>(i) * 0x9E3779B9u ^ 0x2545F491u);
+        }
+    }
+
+    /**
+     * @brief Flat HRW: score every machine, keep the best `count`
+     */
+    vector<int> topScores(uint32_t h, size_t count, int exclude) const {
+        size_t n = seeds.size();
+        vector<uint32_t> scores(n);
+        const uint32_t* seed = seeds.data();
+        uint32_t* score = scores.data();
+        for (size_t i = 0; i < n; i++) {
+            score[i] = mix32(seed[i] ^ h);      // Branch-free: vectorized
+        }
+
+        vector<size_t> best;                    // Indices, highest score first
+        for (size_t i = 0; i < n; i++) {
+            if (best.size() == count && score[i] <= score[best.back()]) continue;
+            if (ids[i] == exclude) continue;
+            size_t pos = best.size();
+            while (pos > 0 && score[best[pos - 1]] < score[i]) pos--;
+            best.insert(best.begin() + static_cast<long>(pos), i);
+            if (best.size() > count) best.pop_back();
+        }
+        vector<int> result;
+        for (size_t i : best) result.push_back(ids[i]);
+        return result;
+    }
+
+    /**
+     * @brief Place every machine in its leaves and recount subtree weights
+     * @details A machine's leaves depend only on its own seed, never on the
+     *          other machines, so membership changes leave the rest in place.
+     */
+    void assignLeaves() {
+        for (SkeletonNode& node : skeleton) {
+            node.weight = 0;
+            node.members.clear();
+        }
+        size_t leafCount = skeleton.size() - firstLeaf;
+        size_t wanted = min(MACHINE_LEAVES, leafCount);
+        vector<size_t> joined;
+        for (size_t m = 0; m < ids.size(); m++) {
+            joined.clear();
+            for (uint32_t attempt = 0; joined.size() < wanted; attempt++) {
+                size_t leaf = leafOf(mix32(seeds[m] + attempt * 0x9E3779B9u));
+                if (find(joined.begin(), joined.end(), leaf) != joined.end()) continue;
+                joined.push_back(leaf);
+                skeleton[leaf].members.push_back(static_cast<int>(m));
+                for (size_t node = leaf;; node = (node - 1) / FANOUT) {
+                    skeleton[node].weight++;
+                    if (node == 0) break;
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Leaf reached from the root by taking the child with the highest mix32(h ^ label)
+     */
+    size_t leafOf(uint32_t h) const {
+        size_t node = 0;
+        while (node < firstLeaf) {
+            size_t best = FANOUT * node + 1;
+            for (size_t c = best + 1; c <= FANOUT * node + FANOUT; c++) {
+                if (mix32(h ^ skeleton[c].label) > mix32(h ^ skeleton[best].label)) best = c;
+            }
+            node = best;
+        }
+        return node;
+    }
+
+    /**
+     * @brief Best machine below node that is not chosen yet, or -1
+     */
+    int descend(size_t node, uint32_t h, const vector<int>& chosen) const {
+        const SkeletonNode& current = skeleton[node];
+        if (node >= firstLeaf) {
+            int best = -1;
+            uint32_t bestScore = 0;
+            for (int m : current.members) {
+                if (find(chosen.begin(), chosen.end(), m) != chosen.end()) continue;
+                uint32_t s = mix32(seeds[static_cast<size_t>(m)] ^ h);
+                if (best < 0 || s > bestScore) {
+                    best = m;
+                    bestScore = s;
+                }
+            }
+            return best;
+        }
+
+        // Non-empty children in descending score order; fall back if a subtree is used up
+        vector<pair<uint32_t, size_t>> order;
+        for (size_t child = FANOUT * node + 1; child <= FANOUT * node + FANOUT; child++) {
+            const SkeletonNode& c = skeleton[child];
+            if (c.weight > 0) order.push_back({ mix32(c.label ^ h), child });
+        }
+        sort(order.begin(), order.end(), greater<pair<uint32_t, size_t>>());
+        for (const auto& entry : order) {
+            int pick = descend(entry.second, h, chosen);
+            if (pick >= 0) return pick;
+        }
+        return -1;
+    }
+};
@@ -0,0 +1,175 @@
+/**
+ * @file ShortcutCache.h
+ * @brief Small per-machine set of learned shortcut links
+ * @details A machine remembers the owners its own lookups end at, up to a
+ *          fixed number of slots. Each reuse bumps a counter. Every lookup,
+ *          cached or not, is also counted in a small count-min sketch
+ *          (W-TinyLFU admission). A new destination always enters the window
+ *          slot (entries[0]) with the sketch's count instead of 1. The link
+ *          it pushes out of the window replaces the least used main link
+ *          only if the sketch has seen it more often. So a one-off
+ *          destination cannot evict a useful link, and a newly popular one
+ *          is not the next victim. Counters and sketch are halved every few
+ *          hundred uses so old favourites fade. Entries are machine IDs,
+ *          resolved through the ring's index when used, so a machine that
+ *          has left is simply skipped.
+ *
+ * Compile: g++ -std=c++17 -Wall -o ipfs_dht src/main.cpp
+ */
+
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+using namespace std;
+
+/**
+ * @brief Bounded usage-counted set of shortcut destinations
+ */
+class ShortcutCache {
+public:
+    static constexpr int DEFAULT_SLOTS = 8;
+    static constexpr int MAX_SLOTS = 64;
+    static constexpr uint32_t AGING_PERIOD = 256;   // Uses between halvings
+    static constexpr int SKETCH_PER_SLOT = 32;      // One-byte sketch counters per slot
+
+    /**
+     * @brief One shortcut link
+     */
+    struct Entry {
+        int machine;        // Destination machine ID
+        uint32_t uses;      // Decayed use count
+    };
+
+    vector<Entry> entries;
+
+    ShortcutCache() : capacity(0), sinceAging(0) {}
+
+    bool isEnabled() const { return capacity > 0; }
+
+    /**
+     * @brief Keep at most slots links (0 turns learning off and drops all)
+     */
+    void resize(int slots) {
+        capacity = slots < 0 ? 0 : (slots > MAX_SLOTS ? MAX_SLOTS : slots);
+        while (entries.size() > static_cast<size_t>(capacity)) evictLeastUsed();
+
+        // Power of two so a counter index is a mask; 0 slots keeps no sketch
+        size_t counters = 0;
+        if (capacity > 0) {
+            counters = 16;
+            while (counters < static_cast<size_t>(capacity * SKETCH_PER_SLOT)) counters <<= 1;
+        }
+        if (counters != sketch.size()) sketch.assign(counters, 0);
+    }
+
+    /**
+     * @brief Count one lookup that ended at machine; learn it if new
+     */
+    void record(int machine) {
+        if (capacity == 0) return;
+        if (++sinceAging >= AGING_PERIOD) {
+            for (Entry& e : entries) e.uses >>= 1;
+            for (uint8_t& c : sketch) c >>= 1;
+            sinceAging = 0;
+        }
+        uint32_t seen = countInSketch(machine);
+        for (Entry& e : entries) {
+            if (e.machine == machine) {
+                e.uses++;
+                return;
+            }
+        }
+
+        // The newcomer takes the window slot; the link it displaces replaces
+        // the weakest main link only if the sketch has seen it more often
+        if (entries.size() < static_cast<size_t>(capacity)) {
+            entries.push_back({ machine, seen });
+            swap(entries[0], entries.back());
+            return;
+        }
+        Entry displaced = entries[0];
+        entries[0] = { machine, seen };
+        if (entries.size() == 1) return;
+        size_t victim = leastUsed(1);
+        displaced.uses = max(displaced.uses, estimate(displaced.machine));
+        if (displaced.uses > entries[victim].uses) entries[victim] = displaced;
+    }
+
+    /**
+     * @brief Drop the link to a machine (it left the ring)
+     */
+    void forget(int machine) {
+        for (size_t i = 0; i < entries.size(); i++) {
+            if (entries[i].machine == machine) {
+                entries[i] = entries.back();
+                entries.pop_back();
+                return;
+            }
+        }
+    }
+
+    void clear() {
+        entries.clear();
+        fill(sketch.begin(), sketch.end(), 0);
+        sinceAging = 0;
+    }
+
+private:
+    int capacity;           // Maximum links
+    uint32_t sinceAging;    // Uses since the last halving
+    vector<uint8_t> sketch; // Count-min over lookup destinations, two counters per machine
+
+    /**
+     * @brief Two counter indices come from the low and high half of one hash
+     */
+    static uint32_t sketchHash(int machine) {
+        uint32_t h = static_cast<uint32_t>(machine) * 0x9E3779B1u;
+        h ^= h >> 15;
+        h *= 0x85EBCA6Bu;
+        h ^= h >> 13;
+        return h;
+    }
+
+    /**
+     * @brief Count one more lookup ending at machine; returns its estimate
+     * @details Conservative update: only the smaller counter grows, which
+     *          keeps collisions from inflating the estimate.
+     */
+    uint32_t countInSketch(int machine) {
+        uint32_t h = sketchHash(machine);
+        size_t mask = sketch.size() - 1;
+        uint8_t& a = sketch[h & mask];
+        uint8_t& b = sketch[(h >> 16) & mask];
+        uint8_t low = min(a, b);
+        if (low < 255) {
+            if (a == low) a++;
+            if (b == low) b++;
+            low++;
+        }
+        return low;
+    }
+
+    /**
+     * @brief Lookups seen for machine, without counting one
+     */
+    uint32_t estimate(int machine) const {
+        uint32_t h = sketchHash(machine);
+        size_t mask = sketch.size() - 1;
+        return min(sketch[h & mask], sketch[(h >> 16) & mask]);
+    }
+
+    size_t leastUsed(size_t from = 0) const {
+        size_t victim = from;
+        for (size_t i = from + 1; i < entries.size(); i++) {
+            if (entries[i].uses < entries[victim].uses) victim = i;
+        }
+        return victim;
+    }
+
+    void evictLeastUsed() {
+        size_t victim = leastUsed();
+        entries[victim] = entries.back();
+        entries.pop_back();
+    }
+};
@@ -0,0 +1,60 @@
+/**
+ * @file SingleFlight.h
+ * @brief Single-flight table: concurrent requests for one key share one call
+ * @details The first request for a key runs the work and records its result;
+ *          every later request for the same key while the call is in flight
+ *          attaches to it and gets the same result without doing the work
+ *          again. land() ends the flight (the answer went out to everyone
+ *          waiting), so the next request runs fresh and never sees a stale
+ *          result.
+ *
+ * Compile: g++ -std=c++17 -Wall -o ipfs_dht src/main.cpp
+ */
+
+#pragma once
+#include <unordered_map>
+using namespace std;
+
+/**
+ * @brief In-flight calls keyed by request key
+ */
+template<typename Key, typename Result>
+class SingleFlight {
+public:
+    long long leaders;      // Requests that ran the work
+    long long followers;    // Requests that attached to a call in flight
+
+    SingleFlight() : leaders(0), followers(0) {}
+
+    /**
+     * @brief Result of the call in flight for key, running work() if there is none
+     */
+    template<typename Work>
+    Result run(const Key& key, Work work) {
+        auto it = calls.find(key);
+        if (it != calls.end()) {
+            followers++;
+            return it->second;
+        }
+        leaders++;
+        Result result = work();
+        calls.emplace(key, result);
+        return result;
+    }
+
+    bool inFlight(const Key& key) const { return calls.count(key) > 0; }
+
+    void reserve(size_t expected) { calls.reserve(expected); }
+
+    size_t size() const { return calls.size(); }
+
+    /**
+     * @brief End every call in flight; later requests run the work again
+     */
+    void land() {
+        calls.clear();
+    }
+
+private:
+    unordered_map<Key, Result> calls;
+};
@@ -0,0 +1,392 @@
+/**
+ * @file SuccessorTrie.h
+ * @brief Layered-bitmap van Emde Boas variant for successor queries
+ * @details A 64-ary trie over IDs of up to 64 bits. Every level is a hash map
+ *          from ID prefix to a 64-bit child bitmap, like an x-fast trie with
+ *          word-sized fan-out. succ/pred binary-search the levels for the
+ *          deepest existing prefix, so a query costs O(log log U) hash probes
+ *          and memory stays O(N log U / 6) instead of O(U).
+ *
+ * Compile: g++ -std=c++17 -Wall -o ipfs_dht src/main.cpp
+ */
+
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "OccupancyBitmap.h"
+using namespace std;
+
+/**
+ * @brief Open-addressing hash map from 64-bit prefix to a trie node
+ * @details Linear probing with backward-shift deletion; one probe usually
+ *          touches a single cache line, unlike node-based unordered_map.
+ *          Pointers returned by find()/insert() are invalidated by insert/erase.
+ */
+template<typename Value>
+class PrefixMap {
+public:
+    static constexpr uint64_t EMPTY = ~0ULL;   // Prefixes are < 2^58
+
+    struct Slot {
+        uint64_t key;
+        Value value;
+    };
+
+    vector<Slot> slots;
+    size_t used;
+
+    PrefixMap() : used(0) {}
+
+    size_t size() const { return used; }
+
+    void clear() {
+        vector<Slot>().swap(slots);
+        used = 0;
+    }
+
+    Value* find(uint64_t key) {
+        if (slots.empty()) return nullptr;
+        size_t mask = slots.size() - 1;
+        for (size_t i = hashOf(key) & mask; ; i = (i + 1) & mask) {
+            if (slots[i].key == key) return &slots[i].value;
+            if (slots[i].key == EMPTY) return nullptr;
+        }
+    }
+
+    const Value* find(uint64_t key) const {
+        return const_cast<PrefixMap*>(this)->find(key);
+    }
+
+    bool contains(uint64_t key) const { return find(key) != nullptr; }
+
+    /**
+     * @brief Insert key with value unless present; return the stored value
+     */
+    Value& insert(uint64_t key, const Value& value) {
+        if ((used + 1) * 10 > slots.size() * 7) grow();
+        size_t mask = slots.size() - 1;
+        size_t i = hashOf(key) & mask;
+        while (slots[i].key != EMPTY && slots[i].key != key) {
+            i = (i + 1) & mask;
+        }
+        if (slots[i].key == EMPTY) {
+            slots[i].key = key;
+            slots[i].value = value;
+            used++;
+        }
+        return slots[i].value;
+    }
+
+    void erase(uint64_t key) {
+        if (slots.empty()) return;
+        size_t mask = slots.size() - 1;
+        size_t i = hashOf(key) & mask;
+        while (slots[i].key != key) {
+            if (slots[i].key == EMPTY) return;
+            i = (i + 1) & mask;
+        }
+
+        // Backward-shift later entries of the probe run into the hole
+        size_t hole = i;
+        for (size_t j = (i + 1) & mask; slots[j].key != EMPTY; j = (j + 1) & mask) {
+            size_t home = hashOf(slots[j].key) & mask;
+            bool movable = (hole <= j) ? (home <= hole || home > j) : (home <= hole && home > j);
+            if (movable) {
+                slots[hole] = slots[j];
+                hole = j;
+            }
+        }
+        slots[hole].key = EMPTY;
+        used--;
+    }
+
+    size_t memoryBytes() const { return slots.capacity() * sizeof(Slot); }
+
+private:
+    static size_t hashOf(uint64_t key) {
+        key ^= key >> 33;
+        key *= 0xff51afd7ed558ccdULL;
+        key ^= key >> 33;
+        return static_cast<size_t>(key);
+    }
+
+    void grow() {
+        vector<Slot> old;
+        old.swap(slots);
+        Slot empty;
+        empty.key = EMPTY;
+        empty.value = Value();
+        slots.assign(old.empty() ? 16 : old.size() * 2, empty);
+        used = 0;
+        for (const Slot& slot : old) {
+            if (slot.key != EMPTY) insert(slot.key, slot.value);
+        }
+    }
+};
+
+/**
+ * @brief Ordered set of 64-bit keys with O(log log U) successor/predecessor
+ */
+class SuccessorTrie {
+public:
+    static constexpr uint64_t NONE = ~0ULL;
+    static constexpr int DIGIT_BITS = 6;           // 64 children per node
+
+    /**
+     * @brief Bottom level: 64 keys per word, linked to neighbouring leaves
+     */
+    struct Leaf {
+        uint64_t bits;
+        uint64_t prev;      // Prefix of previous non-empty leaf (NONE if first)
+        uint64_t next;      // Prefix of next non-empty leaf (NONE if last)
+    };
+
+    /**
+     * @brief Upper levels: child bitmap plus subtree min/max for O(1) descent
+     */
+    struct Inner {
+        uint64_t bits;
+        uint64_t minKey;
+        uint64_t maxKey;
+    };
+
+    int universeBits;                               // Key width (1-64)
+    int levels;                                     // Leaf level + inner levels
+    PrefixMap<Leaf> leaves;                         // Level 0
+    vector<PrefixMap<Inner>> inner;                 // inner[l-1] = level l
+    size_t count;
+
+    SuccessorTrie() : universeBits(0), levels(0), count(0) {}
+
+    explicit SuccessorTrie(int bits) : universeBits(0), levels(0), count(0) {
+        init(bits);
+    }
+
+    bool isEnabled() const { return universeBits > 0; }
+
+    void init(int bits) {
+        if (bits < 1) bits = 1;
+        if (bits > 64) bits = 64;
+        universeBits = bits;
+        levels = (bits + DIGIT_BITS - 1) / DIGIT_BITS;
+        if (levels < 1) levels = 1;
+        leaves.clear();
+        inner.assign(levels - 1, PrefixMap<Inner>());
+        count = 0;
+    }
+
+    void release() {
+        leaves.clear();
+        vector<PrefixMap<Inner>>().swap(inner);
+        universeBits = 0;
+        levels = 0;
+        count = 0;
+    }
+
+    size_t size() const { return count; }
+
+    bool contains(uint64_t key) const {
+        const Leaf* leaf = leaves.find(prefixAt(key, 0));
+        return leaf != nullptr && ((leaf->bits >> digitAt(key, 0)) & 1);
+    }
+
+    /**
+     * @brief Insert a key, O(levels)
+     */
+    void insert(uint64_t key) {
+        if (contains(key)) return;
+
+        uint64_t leafPrefix = prefixAt(key, 0);
+        Leaf* leaf = leaves.find(leafPrefix);
+        if (leaf == nullptr) {
+            // New leaf: splice it between the leaves of its neighbours
+            uint64_t before = predecessor(key);
+            uint64_t after = successor(key);
+            Leaf fresh;
+            fresh.bits = 0;
+            fresh.prev = before == NONE ? NONE : prefixAt(before, 0);
+            fresh.next = after == NONE ? NONE : prefixAt(after, 0);
+            if (fresh.prev != NONE) leaves.find(fresh.prev)->next = leafPrefix;
+            if (fresh.next != NONE) leaves.find(fresh.next)->prev = leafPrefix;
+            leaf = &leaves.insert(leafPrefix, fresh);
+        }
+        leaf->bits |= 1ULL << digitAt(key, 0);
+
+        for (int l = 1; l < levels; l++) {
+            Inner fresh = { 0, key, key };
+            Inner& node = inner[l - 1].insert(prefixAt(key, l), fresh);
+            node.bits |= 1ULL << digitAt(key, l);
+            if (key < node.minKey) node.minKey = key;
+            if (key > node.maxKey) node.maxKey = key;
+        }
+        count++;
+    }
+
+    /**
+     * @brief Remove a key, O(levels)
+     */
+    void erase(uint64_t key) {
+        if (!contains(key)) return;
+
+        uint64_t leafPrefix = prefixAt(key, 0);
+        Leaf* leaf = leaves.find(leafPrefix);
+        leaf->bits &= ~(1ULL << digitAt(key, 0));
+        bool childEmpty = (leaf->bits == 0);
+        if (childEmpty) {
+            uint64_t prev = leaf->prev, next = leaf->next;
+            if (prev != NONE) leaves.find(prev)->next = next;
+            if (next != NONE) leaves.find(next)->prev = prev;
+            leaves.erase(leafPrefix);
+        }
+
+        for (int l = 1; l < levels; l++) {
+            uint64_t prefix = prefixAt(key, l);
+            Inner* n = inner[l - 1].find(prefix);
+            if (childEmpty) {
+                n->bits &= ~(1ULL << digitAt(key, l));
+                if (n->bits == 0) {
+                    inner[l - 1].erase(prefix);
+                    continue;   // Parent loses this child too
+                }
+                childEmpty = false;
+            }
+            if (n->minKey == key) n->minKey = childMin(l, prefix, ctz64(n->bits));
+            if (n->maxKey == key) n->maxKey = childMax(l, prefix, msb64(n->bits));
+        }
+        count--;
+    }
+
+    /**
+     * @brief Smallest key >= x, or NONE
+     */
+    uint64_t successor(uint64_t x) const {
+        int l = deepestLevel(x);
+        if (l < 0) return NONE;
+
+        uint64_t prefix = prefixAt(x, l);
+        int d = digitAt(x, l);
+
+        if (l == 0) {
+            const Leaf& leaf = *leaves.find(prefix);
+            uint64_t m = leaf.bits & (~0ULL << d);
+            if (m) return (prefix << DIGIT_BITS) | ctz64(m);
+            return leaf.next == NONE ? NONE : leafMin(leaf.next);
+        }
+
+        // Child d is absent (l is the deepest existing level)
+        const Inner& node = *inner[l - 1].find(prefix);
+        uint64_t above = d == 63 ? 0 : (node.bits & (~0ULL << (d + 1)));
+        if (above) return childMin(l, prefix, ctz64(above));
+
+        // Everything under this node is < x: step from its max to the next leaf
+        const Leaf& last = *leaves.find(prefixAt(node.maxKey, 0));
+        return last.next == NONE ? NONE : leafMin(last.next);
+    }
+
+    /**
+     * @brief Largest key < x, or NONE
+     */
+    uint64_t predecessor(uint64_t x) const {
+        if (x == 0) return NONE;
+        uint64_t y = x - 1;     // Largest key <= y
+        int l = deepestLevel(y);
+        if (l < 0) return NONE;
+
+        uint64_t prefix = prefixAt(y, l);
+        int d = digitAt(y, l);
+
+        if (l == 0) {
+            const Leaf& leaf = *leaves.find(prefix);
+            uint64_t m = leaf.bits & (d == 63 ? ~0ULL : ((1ULL << (d + 1)) - 1));
+            if (m) return (prefix << DIGIT_BITS) | msb64(m);
+            return leaf.prev == NONE ? NONE : leafMax(leaf.prev);
+        }
+
+        const Inner& node = *inner[l - 1].find(prefix);
+        uint64_t below = node.bits & ((1ULL << d) - 1);
+        if (below) return childMax(l, prefix, msb64(below));
+
+        // Everything under this node is > y: step from its min to the previous leaf
+        const Leaf& first = *leaves.find(prefixAt(node.minKey, 0));
+        return first.prev == NONE ? NONE : leafMax(first.prev);
+    }
+
+    uint64_t minimum() const { return successor(0); }
+
+    uint64_t maximum() const {
+        uint64_t top = universeBits >= 64 ? ~0ULL : ((1ULL << universeBits) - 1);
+        if (contains(top)) return top;
+        return predecessor(top);
+    }
+
+    /**
+     * @brief Approximate heap footprint of all levels
+     */
+    size_t memoryBytes() const {
+        size_t total = leaves.memoryBytes();
+        for (const auto& levelMap : inner) {
+            total += levelMap.memoryBytes();
+        }
+        return total;
+    }
+
+private:
+    /**
+     * @brief Prefix identifying the level-l node that holds key
+     */
+    static uint64_t prefixAt(uint64_t key, int l) {
+        int shift = DIGIT_BITS * (l + 1);
+        return shift >= 64 ? 0 : (key >> shift);
+    }
+
+    /**
+     * @brief Child index of key inside its level-l node
+     */
+    static int digitAt(uint64_t key, int l) {
+        int shift = DIGIT_BITS * l;
+        return shift >= 64 ? 0 : static_cast<int>((key >> shift) & 63);
+    }
+
+    bool exists(uint64_t key, int l) const {
+        if (l == 0) return leaves.contains(prefixAt(key, 0));
+        return inner[l - 1].contains(prefixAt(key, l));
+    }
+
+    /**
+     * @brief Lowest level whose node on key's path exists, or -1 if empty
+     * @details Existence is monotone in l, so binary search: O(log levels)
+     */
+    int deepestLevel(uint64_t key) const {
+        if (!exists(key, levels - 1)) return -1;
+        int lo = 0, hi = levels - 1;
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (exists(key, mid)) hi = mid;
+            else lo = mid + 1;
+        }
+        return lo;
+    }
+
+    uint64_t leafMin(uint64_t prefix) const {
+        return (prefix << DIGIT_BITS) | ctz64(leaves.find(prefix)->bits);
+    }
+
+    uint64_t leafMax(uint64_t prefix) const {
+        return (prefix << DIGIT_BITS) | msb64(leaves.find(prefix)->bits);
+    }
+
+    /**
+     * @brief Min key below child c of the level-l node with the given prefix
+     */
+    uint64_t childMin(int l, uint64_t prefix, int c) const {
+        uint64_t child = (prefix << DIGIT_BITS) | static_cast<uint64_t>(c);
+        if (l == 1) return leafMin(child);
+        return inner[l - 2].find(child)->minKey;
+    }
+
+    uint64_t childMax(int l, uint64_t prefix, int c) const {
+        uint64_t child = (prefix << DIGIT_BITS) | static_cast<uint64_t>(c);
+        if (l == 1) return leafMax(child);
+        return inner[l - 2].find(child)->maxKey;
+    }
+};
@@ -12,7 +12,7 @@
  *          - O(log N) routing using finger tables
  *          - File operations from ANY machine
  * 
- * Compile: g++ -std=c++17 -Wall -Wextra -O2 -o ipfs_dht src/main.cpp
+ * Compile: g++ -std=c++17 -Wall -Wextra -O2 -pthread -o ipfs_dht src/main.cpp
  */
 
 #include <iostream>
@@ -63,6 +63,13 @@ bool initializeSystem() {
     cout << "  ID Range: 0 to " << (identifierSpace - 1) << "\n";
     cout << "  Total possible IDs: " << identifierSpace << "\n";
     
+    bool directMapped = false;
+    if (bits <= OwnerTable<CircularNode>::MAX_BITS) {
+        cout << "\n  This space is small enough to precompute the owner of every ID,\n";
+        cout << "  making file placement and lookup a single array read.\n";
+        directMapped = getConfirmation("Enable direct-mapped responsibility table?");
+    }
+    
     // Get B-tree order
     cout << "\n  +------------------------------------------------------------------------+\n";
     cout << "  |  STEP 2: Configure B-Tree Order                                        |\n";
@@ -72,9 +79,91 @@ bool initializeSystem() {
     
     btreeOrder = getIntInput("Enter B-tree order (3-100): ", 3, 100);
     
+    cout << "\n  How should file keys be assigned to machines?\n";
+    cout << "  1. Chord ring - Successor of the key (finger-table routing)\n";
+    cout << "  2. Jump hash - O(1) consistent hash over the machine list\n";
+    cout << "  3. Maglev - O(1) lookup table over the machine list\n\n";
+    int placementChoice = getIntInput("Enter choice (1-3): ", 1, 3);
+    PlacementMode placement = placementChoice == 2 ? PlacementMode::Jump
+                            : placementChoice == 3 ? PlacementMode::Maglev : PlacementMode::Ring;
+    
+    RoutingMode routing = RoutingMode::Chord;
+    int routingDigitBits = 0;
+    int fingerBase = 2;
+    bool bidirectional = false;
+    int shortcutSlots = 0;
+    if (placement == PlacementMode::Ring) {
+        cout << "\n  How should lookups be routed between machines?\n";
+        cout << "  1. Chord - Finger tables, O(log2 N) hops\n";
+        cout << "  2. Pastry - Prefix routing tables + leaf sets, O(log_2^b N) hops\n";
+        cout << "  3. Koorde - de Bruijn pointers, constant degree, O(log N) hops\n\n";
+        int routingChoice = getIntInput("Enter choice (1-3): ", 1, 3);
+        if (routingChoice == 1) {
+            fingerBase = getIntInput("Finger base k, fingers at n + j*k^i (2 = classic Chord, up to "
+                                     + to_string(CircularLinkedList::MAX_FINGER_BASE) + "): ",
+                                     2, CircularLinkedList::MAX_FINGER_BASE);
+            bidirectional = getConfirmation("Keep counter-clockwise fingers too (route both ways)?");
+            if (getConfirmation("Learn shortcut links from lookup traffic?")) {
+                shortcutSlots = getIntInput("Shortcut links per machine (1-" + to_string(ShortcutCache::MAX_SLOTS)
+                                            + "): ", 1, ShortcutCache::MAX_SLOTS);
+            }
+        } else if (routingChoice == 2) {
+            routing = RoutingMode::Pastry;
+            routingDigitBits = getIntInput("Bits per digit b (1-" + to_string(PastryRouter::MAX_DIGIT_BITS) + "): ",
+                                           1, PastryRouter::MAX_DIGIT_BITS);
+        } else if (routingChoice == 3) {
+            routing = RoutingMode::Koorde;
+            routingDigitBits = getIntInput("Bits shifted per hop c, degree 2^c (1-"
+                                           + to_string(KoordeRouter::MAX_DIGIT_BITS) + "): ",
+                                           1, KoordeRouter::MAX_DIGIT_BITS);
+        }
+    }
+    
+    int rebalanceRate = 0;
+    if (placement == PlacementMode::Ring) {
+        cout << "\n  New machines can receive their files in the background at a fixed\n";
+        cout << "  rate instead of all at once, keeping lookups fast during large joins.\n";
+        if (getConfirmation("Throttle file moves after joins (background rebalancer)?")) {
+            rebalanceRate = getIntInput("Files moved per second (1-1000000): ", 1, 1000000);
+        }
+    }
+    
+    cout << "\n  Files can be stored on several machines for fault tolerance.\n";
+    int replicaFactor = 1;
+    ReplicaMode replicaMode = ReplicaMode::None;
+    if (getConfirmation("Replicate files?")) {
+        replicaFactor = getIntInput("Copies per file, including the primary (2-" + to_string(ReplicaSelector::MAX_FACTOR)
+                                    + "): ", 2, ReplicaSelector::MAX_FACTOR);
+        cout << "\n  1. Successor list - The machines after the primary on the ring\n";
+        cout << "  2. Rendezvous - Highest random weight over all machines\n";
+        cout << "  3. Rendezvous skeleton - HRW over a machine hierarchy, O(log N)\n\n";
+        int modeChoice = getIntInput("Enter choice (1-3): ", 1, 3);
+        replicaMode = modeChoice == 1 ? ReplicaMode::SuccessorList
+                    : modeChoice == 2 ? ReplicaMode::Rendezvous : ReplicaMode::Skeleton;
+    }
+    
     // Create IPFS instance
     cleanup();
     ipfs = new IPFS(bits, btreeOrder);
+    if (directMapped) {
+        ipfs->EnableDirectMapping();
+    }
+    if (rebalanceRate > 0) {
+        ipfs->EnableRebalancer(rebalanceRate);
+    }
+    if (placement != PlacementMode::Ring) {
+        ipfs->SetPlacement(placement);
+    }
+    if (routing != RoutingMode::Chord) {
+        ipfs->SetRouting(routing, routingDigitBits);
+    } else {
+        if (fingerBase != 2) ipfs->SetFingerBase(fingerBase);
+        if (bidirectional) ipfs->SetBidirectional(true);
+        if (shortcutSlots > 0) ipfs->SetShortcuts(shortcutSlots);
+    }
+    if (replicaFactor > 1) {
+        ipfs->EnableReplication(replicaMode, replicaFactor);
+    }
     
     // Get number of machines
     cout << "\n  +------------------------------------------------------------------------+\n";
@@ -88,9 +177,10 @@ bool initializeSystem() {
     cout << "\n  How would you like to assign machine IDs?\n";
     cout << "  1. Manual - Enter each ID yourself\n";
     cout << "  2. Automatic - Use hash function on machine names\n";
-    cout << "  3. Random - Generate random unique IDs\n\n";
+    cout << "  3. Random - Generate random unique IDs\n";
+    cout << "  4. Balanced - Spread IDs evenly over the identifier space\n\n";
     
-    int assignChoice = getIntInput("Enter choice (1-3): ", 1, 3);
+    int assignChoice = getIntInput("Enter choice (1-4): ", 1, 4);
     
     vector<int> machineIds;
     
@@ -151,6 +241,15 @@ bool initializeSystem() {
             }
         }
     } 
+    else if (assignChoice == 4) {
+        // Evenly spaced: every machine starts with an equal arc
+        cout << "\n  Spreading IDs evenly...\n\n";
+        for (int i = 0; i < numMachines; i++) {
+            int id = static_cast<int>(static_cast<long long>(i) * identifierSpace / numMachines);
+            cout << "  Machine " << (i + 1) << " -> ID: " << id << "\n";
+            machineIds.push_back(id);
+        }
+    }
     else {
         // Random assignment
         cout << "\n  Generating random unique IDs...\n\n";
@@ -211,15 +310,57 @@ void addMachine() {
     
     cout << "\n  How would you like to assign the ID?\n";
     cout << "  1. Manual - Enter ID yourself\n";
-    cout << "  2. Automatic - Use hash of machine name\n\n";
+    cout << "  2. Automatic - Use hash of machine name\n";
+    cout << "  3. Smart - Split the most loaded part of the ring\n";
+    cout << "  4. Weighted host - Several positions scaled by capacity\n\n";
     
-    int choice = getIntInput("Enter choice (1-2): ", 1, 2);
+    int choice = getIntInput("Enter choice (1-4): ", 1, 4);
+    
+    if (choice == 4) {
+        string name;
+        cout << "  Enter host name: ";
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        getline(cin, name);
+        int weight = getIntInput("Enter capacity weight (1-" + to_string(HostRegistry::MAX_WEIGHT) + "): ",
+                                 1, HostRegistry::MAX_WEIGHT);
+        
+        if (ipfs->AddHost(name, weight)) {
+            cout << "\n  Host \"" << name << "\" joined with weight " << weight << ".\n";
+            ipfs->PrintHostReport();
+        }
+        waitForEnter();
+        return;
+    }
     
     int machineId;
     
     if (choice == 1) {
         machineId = getIntInput("Enter machine ID (0-" + to_string(ipfs->getMaxId()) + "): ", 
                                  0, ipfs->getMaxId());
+    } else if (choice == 3) {
+        cout << "\n  Balance by:\n";
+        cout << "  1. Key space - largest range of IDs\n";
+        cout << "  2. Files - most files stored\n";
+        cout << "  3. Requests - most file lookups served\n\n";
+        
+        int metricChoice = getIntInput("Enter choice (1-3): ", 1, 3);
+        LoadMetric metric = metricChoice == 1 ? LoadMetric::KeySpace
+                          : metricChoice == 2 ? LoadMetric::Files : LoadMetric::Requests;
+        JoinProposal proposal = ipfs->ProposeJoinId(metric);
+        
+        if (proposal.id < 0) {
+            printError("No range left to split!");
+            waitForEnter();
+            return;
+        }
+        
+        cout << "\n  Proposed ID: " << proposal.id;
+        if (proposal.splits >= 0) {
+            cout << " (splits Machine " << proposal.splits << ", load " << proposal.load
+                 << ", new machine takes ~" << proposal.moved << ")";
+        }
+        cout << "\n";
+        machineId = proposal.id;
     } else {
         string name;
         cout << "  Enter machine name: ";
@@ -269,8 +410,30 @@ void removeMachine() {
         return;
     }
     
+    const HostRegistry::Host* host = ipfs->hosts.hostOf(machineId);
+    if (host != nullptr) {
+        // A host's positions only leave through its weight, so the registry stays in sync
+        if (getConfirmation("Machine " + to_string(machineId) + " is a position of host \""
+                            + host->name + "\". Remove the whole host?")) {
+            string hostName = host->name;   // Registry entry is erased by RemoveHost
+            ipfs->RemoveHost(hostName);
+            
+            cout << "\n  Updated Ring:\n";
+            ipfs->printRing();
+        } else {
+            printError("Positions of host \"" + host->name + "\" leave only with the whole host.");
+        }
+        waitForEnter();
+        return;
+    }
+    
     if (getConfirmation("Are you sure you want to remove Machine " + to_string(machineId) + "?")) {
-        ipfs->DeleteMachine(machineId, btreeOrder);
+        if (ipfs->getPlacement() == PlacementMode::Ring &&
+            getConfirmation("Drain gracefully (keep serving while files migrate in the background)?")) {
+            ipfs->DrainMachine(machineId);
+        } else {
+            ipfs->DeleteMachine(machineId, btreeOrder);
+        }
         
         cout << "\n  Updated Ring:\n";
         ipfs->printRing();
@@ -512,6 +675,9 @@ void viewStatus() {
     clearScreen();
     printHeader();
     ipfs->printDetailedStatus();
+    if (!ipfs->hosts.isEmpty()) {
+        ipfs->PrintHostReport();
+    }
     waitForEnter();
 }
 
@@ -599,6 +765,15 @@ int main() {
                 printError("Invalid choice!");
                 waitForEnter();
         }
+        
+        // Background migration: each operation advances draining machines by one
+        // chunk and lets the rebalancer use the time since the last operation
+        if (running && initialized && ipfs->isDraining()) {
+            ipfs->PumpDrains();
+        }
+        if (running && initialized && ipfs->isRebalancing()) {
+            ipfs->PumpRebalancer();
+        }
     }
     
     cleanup();